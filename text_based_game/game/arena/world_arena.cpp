@@ -0,0 +1,21 @@
+#include "world_arena.hpp"
+
+world_arena::world_arena() : content_memory(64 * 1024) {}
+
+void* world_arena::allocate(arena_region region, size_t bytes, size_t alignment) {
+    std::lock_guard<std::mutex> guard(lock);
+    if (region == arena_region::content) {
+        return content_memory.allocate(bytes, alignment);
+    }
+    return state_memory.allocate(bytes, alignment);
+}
+
+void world_arena::deallocate(arena_region region, void* pointer, size_t bytes, size_t alignment) {
+    std::lock_guard<std::mutex> guard(lock);
+    if (region == arena_region::content) {
+        content_memory.deallocate(pointer, bytes, alignment);
+    }
+    else {
+        state_memory.deallocate(pointer, bytes, alignment);
+    }
+}
@@ -0,0 +1,77 @@
+#ifndef WORLD_ARENA_HPP
+#define WORLD_ARENA_HPP
+
+#include "../includes.hpp"
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <cstddef>
+
+enum class arena_region {
+    content,
+    state
+};
+
+// Backing memory for one world. Content blocks that are built once and then
+// shared copy-on-write go to a monotonic buffer; the per-session room, item
+// and NPC objects go to a pool so they can be recycled during play. Every
+// allocation holds a reference to the arena, so it is released in one step
+// once the last object allocated from it is gone.
+class world_arena {
+private:
+    std::mutex lock;
+    std::pmr::monotonic_buffer_resource content_memory;
+    std::pmr::unsynchronized_pool_resource state_memory;
+
+public:
+    world_arena();
+    world_arena(const world_arena&) = delete;
+    world_arena& operator=(const world_arena&) = delete;
+
+    void* allocate(arena_region region, size_t bytes, size_t alignment);
+    void deallocate(arena_region region, void* pointer, size_t bytes, size_t alignment);
+};
+
+template <typename T>
+class arena_allocator {
+public:
+    using value_type = T;
+
+    std::shared_ptr<world_arena> arena;
+    arena_region region;
+
+    arena_allocator(std::shared_ptr<world_arena> owner, arena_region memory_region) :
+        arena(std::move(owner)), region(memory_region) {}
+
+    template <typename U>
+    arena_allocator(const arena_allocator<U>& other) :
+        arena(other.arena), region(other.region) {}
+
+    T* allocate(size_t count) {
+        return static_cast<T*>(arena->allocate(region, count * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T* pointer, size_t count) {
+        arena->deallocate(region, pointer, count * sizeof(T), alignof(T));
+    }
+
+    template <typename U>
+    bool operator==(const arena_allocator<U>& other) const {
+        return arena == other.arena && region == other.region;
+    }
+
+    template <typename U>
+    bool operator!=(const arena_allocator<U>& other) const {
+        return !(*this == other);
+    }
+};
+
+template <typename T, typename... Args>
+std::shared_ptr<T> make_arena_shared(const std::shared_ptr<world_arena>& arena, arena_region region, Args&&... args) {
+    if (!arena) {
+        return std::make_shared<T>(std::forward<Args>(args)...);
+    }
+    return std::allocate_shared<T>(arena_allocator<T>(arena, region), std::forward<Args>(args)...);
+}
+
+#endif
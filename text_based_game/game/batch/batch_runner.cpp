@@ -0,0 +1,49 @@
+#include "batch_runner.hpp"
+#include "stream_redirect.hpp"
+#include <sstream>
+
+batch_runner::batch_runner(game_engine& target, bool prompts) :
+    engine(target), show_prompts(prompts) {}
+
+void batch_runner::start(std::ostream& output) {
+    std::istringstream no_input;
+    stream_redirect redirect(no_input, output);
+
+    engine.print_welcome();
+    engine.initialize();
+    engine.start();
+    if (show_prompts) {
+        std::cout << "> ";
+    }
+}
+
+size_t batch_runner::run(std::istream& commands, std::ostream& output) {
+    stream_redirect redirect(commands, output);
+
+    size_t executed = 0;
+    std::string command;
+    while (engine.is_running() && std::getline(std::cin, command)) {
+        if (!command.empty() && command.back() == '\r') {
+            command.pop_back();
+        }
+
+        if (command.empty()) {
+            continue;
+        }
+
+        engine.handle_command(command);
+        ++executed;
+        if (show_prompts && engine.is_running()) {
+            std::cout << "> ";
+        }
+    }
+
+    return executed;
+}
+
+std::string batch_runner::run(const std::string& commands) {
+    std::istringstream input(commands);
+    std::ostringstream output;
+    run(input, output);
+    return output.str();
+}
@@ -0,0 +1,27 @@
+#ifndef BATCH_RUNNER_HPP
+#define BATCH_RUNNER_HPP
+
+#include "../game_engine/game_engine.hpp"
+#include "../includes.hpp"
+#include <string>
+#include <istream>
+#include <ostream>
+
+// Drives a game_engine from a stream of command lines instead of the
+// console. Prompts raised mid-command (quit confirmation, save file names,
+// riddle answers) read the next line of the same stream, so their answers
+// are written inline after the command that asks for them.
+class batch_runner {
+private:
+    game_engine& engine;
+    bool show_prompts;
+
+public:
+    explicit batch_runner(game_engine& target, bool prompts = true);
+
+    void start(std::ostream& output);
+    size_t run(std::istream& commands, std::ostream& output);
+    std::string run(const std::string& commands);
+};
+
+#endif
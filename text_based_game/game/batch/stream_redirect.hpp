@@ -0,0 +1,29 @@
+#ifndef STREAM_REDIRECT_HPP
+#define STREAM_REDIRECT_HPP
+
+#include "../includes.hpp"
+#include <iostream>
+
+// Points std::cin and std::cout at other streams for the lifetime of the
+// object, so engine code that talks to the console can be driven from buffers.
+class stream_redirect {
+private:
+    std::streambuf* saved_in;
+    std::streambuf* saved_out;
+
+public:
+    stream_redirect(std::istream& in, std::ostream& out) :
+        saved_in(std::cin.rdbuf(in.rdbuf())),
+        saved_out(std::cout.rdbuf(out.rdbuf())) {}
+
+    ~stream_redirect() {
+        std::cin.rdbuf(saved_in);
+        std::cout.rdbuf(saved_out);
+        std::cin.clear();
+    }
+
+    stream_redirect(const stream_redirect&) = delete;
+    stream_redirect& operator=(const stream_redirect&) = delete;
+};
+
+#endif
@@ -1,15 +1,19 @@
 #include "character.hpp"
+#include "../snapshot/world_journal.hpp"
 #include <iostream>
 #include <algorithm>
 
+static const symbol inventory_location = symbol_table::intern("inventory");
+
 character::character(const std::string& char_id) :
-    id(char_id), health(100), inventory_size(10) {}
+    id(symbol_table::intern(char_id)), match_id(symbol_table::intern(to_lower(char_id))), health(100), inventory_size(10), journal(nullptr) {}
 
 void character::set_name(const std::string& char_name) {
     name = char_name;
+    match_name = symbol_table::intern(to_lower(char_name));
 }
 
-std::string character::get_name() const {
+const std::string& character::get_name() const {
     return name;
 }
 
@@ -17,19 +21,42 @@ void character::set_description(const std::string& desc) {
     description = desc;
 }
 
-std::string character::get_description() const {
+const std::string& character::get_description() const {
     return description;
 }
 
-std::string character::get_id() const {
+const std::string& character::get_id() const {
+    return id.str();
+}
+
+symbol character::get_id_symbol() const {
     return id;
 }
 
+const std::string& character::get_match_name() const {
+    return match_name.str();
+}
+
+const std::string& character::get_match_id() const {
+    return match_id.str();
+}
+
 void character::set_current_room(const std::string& room_id) {
+    set_current_room(symbol_table::intern(room_id));
+}
+
+void character::set_current_room(symbol room_id) {
+    if (journal && current_room != room_id) {
+        journal->character_moved(id, room_id);
+    }
     current_room = room_id;
 }
 
-std::string character::get_current_room() const {
+const std::string& character::get_current_room() const {
+    return current_room.str();
+}
+
+symbol character::get_current_room_symbol() const {
     return current_room;
 }
 
@@ -49,19 +76,19 @@ int character::get_inventory_size() const {
     return inventory_size;
 }
 
-bool character::add_to_inventory(const std::shared_ptr<item>& item) {
+bool character::add_to_inventory(item* item) {
     if (inventory.size() >= static_cast<size_t>(inventory_size)) {
         return false;
     }
 
     inventory.push_back(item);
-    item->set_location("inventory");
+    item->set_location(inventory_location);
     return true;
 }
 
 bool character::remove_from_inventory(const std::string& item_id) {
     auto it = std::find_if(inventory.begin(), inventory.end(),
-        [&item_id](const std::shared_ptr<item>& item) {
+        [&item_id](const item* item) {
             return item->get_id() == item_id;
         });
 
@@ -73,7 +100,7 @@ bool character::remove_from_inventory(const std::string& item_id) {
     return false;
 }
 
-std::shared_ptr<item> character::get_item_from_inventory(const std::string& item_id) const {
+item* character::get_item_from_inventory(const std::string& item_id) const {
     for (const auto& item_ptr : inventory) {
         if (item_ptr->get_id() == item_id) {
             return item_ptr;
@@ -83,7 +110,7 @@ std::shared_ptr<item> character::get_item_from_inventory(const std::string& item
     return nullptr;
 }
 
-const std::vector<std::shared_ptr<item>>& character::get_inventory() const {
+const std::vector<item*>& character::get_inventory() const {
     return inventory;
 }
 
@@ -102,3 +129,7 @@ void character::display_inventory() const {
         std::cout << "  " << item_ptr->get_name() << std::endl;
     }
 }
+
+void character::set_journal(world_journal* owner) {
+    journal = owner;
+}
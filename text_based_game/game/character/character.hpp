@@ -2,35 +2,47 @@
 #define CHARACTER_HPP
 
 #include "../item/item.hpp"
+#include "../symbol/symbol_table.hpp"
 #include "../includes.hpp"
 #include <string>
 #include <vector>
-#include <memory>
+
+class world_journal;
 
 class character {
 protected:
-    std::string id;
+    symbol id;
+    symbol match_id;
     std::string name;
+    symbol match_name;
     std::string description;
-    std::string current_room;
+    symbol current_room;
     int health;
-    std::vector<std::shared_ptr<item>> inventory;
+    std::vector<item*> inventory;
     int inventory_size;
+    world_journal* journal;
 
 public:
     character(const std::string& char_id);
     virtual ~character() = default;
 
     void set_name(const std::string& char_name);
-    std::string get_name() const;
+    const std::string& get_name() const;
 
     void set_description(const std::string& desc);
-    std::string get_description() const;
+    const std::string& get_description() const;
+
+    const std::string& get_id() const;
+    symbol get_id_symbol() const;
 
-    std::string get_id() const;
+    // Lowercased name and id, for matching against normalized player input.
+    const std::string& get_match_name() const;
+    const std::string& get_match_id() const;
 
     void set_current_room(const std::string& room_id);
-    std::string get_current_room() const;
+    virtual void set_current_room(symbol room_id);
+    const std::string& get_current_room() const;
+    symbol get_current_room_symbol() const;
 
     void set_health(int hp);
     int get_health() const;
@@ -38,13 +50,15 @@ public:
     void set_inventory_size(int size);
     int get_inventory_size() const;
 
-    bool add_to_inventory(const std::shared_ptr<item>& item);
+    bool add_to_inventory(item* item);
     bool remove_from_inventory(const std::string& item_id);
-    std::shared_ptr<item> get_item_from_inventory(const std::string& item_id) const;
-    const std::vector<std::shared_ptr<item>>& get_inventory() const;
+    item* get_item_from_inventory(const std::string& item_id) const;
+    const std::vector<item*>& get_inventory() const;
     void clear_inventory();
 
     void display_inventory() const;
+
+    void set_journal(world_journal* owner);
 };
 
 #endif 
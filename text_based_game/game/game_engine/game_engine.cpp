@@ -1,5 +1,8 @@
 #include "game_engine.hpp"
 #include "../json_loader/json_loader.hpp"
+#include "../script/default_scripts.hpp"
+#include "../snapshot/world_snapshot.hpp"
+#include "../pack/content_pack.hpp"
 #include <iostream>
 #include <algorithm>
 #include <fstream>
@@ -8,9 +11,47 @@
 
 game_engine::game_engine() : game_running(true), config_path("game_config.json") {}
 
+game_engine::game_engine(std::shared_ptr<const world> shared_world) :
+    world_template(std::move(shared_world)), game_running(true), config_path("game_config.json") {}
+
+std::shared_ptr<const world> game_engine::load_world_template(const std::string& path) {
+    game_engine loader;
+    loader.config_path = path;
+    loader.load_world();
+    return std::make_shared<const world>(std::move(loader.game_world));
+}
+
 void game_engine::initialize() {
+    if (world_template) {
+        game_world = world_template->instantiate();
+    }
+    else {
+        load_world();
+    }
+
+    player_character.set_current_room(game_world.get_starting_room());
+    player_character.set_inventory_size(game_world.get_player_inventory_size());
+
+    for (const auto& item_id : game_world.get_starting_inventory()) {
+        const auto& item = game_world.get_item(item_id);
+        if (item) {
+            player_character.add_to_inventory(item);
+        }
+    }
+
+    player_character.set_health(game_world.get_player_health());
+    print_introduction();
+}
+
+void game_engine::load_world() {
     json_loader loader;
-    bool loaded = loader.load_game_data(config_path, game_world);
+    std::string pack_path = content_pack::pack_path_for(config_path);
+    bool loaded = content_pack::is_current(pack_path, config_path) &&
+        content_pack::load(pack_path, game_world, room_budget);
+
+    if (!loaded) {
+        loaded = loader.load_game_data(config_path, game_world);
+    }
 
     if (!loaded) {
         std::cerr << "Failed to load game data. Creating game world manually." << std::endl;
@@ -18,7 +59,7 @@ void game_engine::initialize() {
         game_world.set_world_name("The Labyrinth of Echoes");
         game_world.set_world_description("A fractured realm where ancient magic and steampunk technology coexist. Centuries ago, a cataclysmic event shattered the world into floating islands, each holding remnants of lost civilizations.");
 
-        auto sanctum = std::make_shared<room>("sanctum_whispers");
+        auto sanctum = game_world.create_room(symbol("sanctum_whispers"));
         sanctum->set_name("Sanctum of Whispers");
         sanctum->set_type("starting_area");
         sanctum->set_short_description("The ancient sanctum");
@@ -31,7 +72,7 @@ void game_engine::initialize() {
         sanctum->add_connection("east", "archive_shadows");
         game_world.add_room(sanctum);
 
-        auto forge = std::make_shared<room>("clockwork_forge");
+        auto forge = game_world.create_room(symbol("clockwork_forge"));
         forge->set_name("Clockwork Forge");
         forge->set_type("puzzle_area");
         forge->set_short_description("The mechanical forge");
@@ -43,7 +84,7 @@ void game_engine::initialize() {
         forge->add_connection("east", "skyward_nexus");
         game_world.add_room(forge);
 
-        auto archive = std::make_shared<room>("archive_shadows");
+        auto archive = game_world.create_room(symbol("archive_shadows"));
         archive->set_name("Archive of Shadows");
         archive->set_type("knowledge_area");
         archive->set_short_description("The shadowy archive");
@@ -52,7 +93,7 @@ void game_engine::initialize() {
         archive->add_connection("north", "skyward_nexus");
         game_world.add_room(archive);
 
-        auto nexus = std::make_shared<room>("skyward_nexus");
+        auto nexus = game_world.create_room(symbol("skyward_nexus"));
         nexus->set_name("Skyward Nexus");
         nexus->set_type("hub_area");
         nexus->set_short_description("The floating nexus");
@@ -65,7 +106,7 @@ void game_engine::initialize() {
         nexus->add_connection("down", "abyssal_trench");
         game_world.add_room(nexus);
 
-        auto peaks = std::make_shared<room>("ember_peaks");
+        auto peaks = game_world.create_room(symbol("ember_peaks"));
         peaks->set_name("Ember Peaks");
         peaks->set_type("combat_area");
         peaks->set_short_description("The burning peaks");
@@ -74,7 +115,7 @@ void game_engine::initialize() {
         peaks->add_connection("east", "veyras_airship");
         game_world.add_room(peaks);
 
-        auto airship = std::make_shared<room>("veyras_airship");
+        auto airship = game_world.create_room(symbol("veyras_airship"));
         airship->set_name("Veyra's Airship");
         airship->set_type("mechanical_area");
         airship->set_short_description("The crystal airship");
@@ -83,7 +124,7 @@ void game_engine::initialize() {
         airship->add_connection("west", "ember_peaks");
         game_world.add_room(airship);
 
-        auto trench = std::make_shared<room>("abyssal_trench");
+        auto trench = game_world.create_room(symbol("abyssal_trench"));
         trench->set_name("Abyssal Trench");
         trench->set_type("underwater_area");
         trench->set_short_description("The dark depths");
@@ -92,7 +133,7 @@ void game_engine::initialize() {
         trench->add_connection("east", "echo_chamber");
         game_world.add_room(trench);
 
-        auto chamber = std::make_shared<room>("echo_chamber");
+        auto chamber = game_world.create_room(symbol("echo_chamber"));
         chamber->set_name("Echo Chamber");
         chamber->set_type("final_area");
         chamber->set_short_description("The crystal chamber");
@@ -103,54 +144,54 @@ void game_engine::initialize() {
         chamber->add_connection("west", "abyssal_trench");
         game_world.add_room(chamber);
 
-        auto guardian = std::make_shared<npc>("guardian_automaton");
+        auto guardian = game_world.create_npc("guardian_automaton");
         guardian->set_name("Guardian Automaton");
         guardian->set_description("A towering mechanical guardian, seemingly inactive.");
         guardian->set_current_room("sanctum_whispers");
         game_world.add_npc(guardian);
 
-        auto librarian = std::make_shared<npc>("librarian");
+        auto librarian = game_world.create_npc("librarian");
         librarian->set_name("The Librarian");
         librarian->set_description("A spectral entity in the Archive of Shadows");
         librarian->set_role("Knowledge Keeper");
         librarian->set_current_room("archive_shadows");
         game_world.add_npc(librarian);
 
-        auto gorath = std::make_shared<npc>("gorath");
+        auto gorath = game_world.create_npc("gorath");
         gorath->set_name("Gorath");
         gorath->set_description("A cursed knight trapped in enchanted armor");
         gorath->set_role("Cursed Knight");
         gorath->set_current_room("ember_peaks");
         game_world.add_npc(gorath);
 
-        auto veyra = std::make_shared<npc>("veyra");
+        auto veyra = game_world.create_npc("veyra");
         veyra->set_name("Veyra");
         veyra->set_description("A rogue inventor seeking the Echo Crystal to power her airship");
         veyra->set_role("Rogue Inventor");
         veyra->set_current_room("veyras_airship");
         game_world.add_npc(veyra);
 
-        auto architect = std::make_shared<npc>("architect");
+        auto architect = game_world.create_npc("architect");
         architect->set_name("The Architect");
         architect->set_description("A mysterious figure who appears in visions");
         architect->set_role("Mysterious Figure");
         architect->set_current_room("echo_chamber");
         game_world.add_npc(architect);
 
-        auto compass = std::make_shared<item>("runed_compass");
+        auto compass = game_world.create_item(symbol("runed_compass"));
         compass->set_name("Runed Compass");
         compass->set_description("Points toward hidden pathways");
         compass->set_type("tool");
         compass->set_property("reveals_secrets", "true");
         game_world.add_item(compass);
 
-        auto key = std::make_shared<item>("clockwork_key");
+        auto key = game_world.create_item(symbol("clockwork_key"));
         key->set_name("Clockwork Key");
         key->set_description("A brass key used to operate steampunk machinery");
         key->set_type("key");
         game_world.add_item(key);
 
-        auto tome = std::make_shared<item>("ancient_tome");
+        auto tome = game_world.create_item(symbol("ancient_tome"));
         tome->set_name("Ancient Tome");
         tome->set_description("Contains cryptic knowledge about the Echo Crystal");
         tome->set_type("book");
@@ -159,35 +200,35 @@ void game_engine::initialize() {
         tome->set_location("archive_shadows");
         game_world.add_item(tome);
 
-        auto large_gear = std::make_shared<item>("large_gear");
+        auto large_gear = game_world.create_item(symbol("large_gear"));
         large_gear->set_name("Large Gear");
         large_gear->set_description("A hefty metal gear that appears to be part of a mechanism");
         large_gear->set_type("part");
         large_gear->set_location("clockwork_forge");
         game_world.add_item(large_gear);
 
-        auto medium_gear = std::make_shared<item>("medium_gear");
+        auto medium_gear = game_world.create_item(symbol("medium_gear"));
         medium_gear->set_name("Medium Gear");
         medium_gear->set_description("A medium-sized gear with intricate teeth");
         medium_gear->set_type("part");
         medium_gear->set_location("clockwork_forge");
         game_world.add_item(medium_gear);
 
-        auto small_gear = std::make_shared<item>("small_gear");
+        auto small_gear = game_world.create_item(symbol("small_gear"));
         small_gear->set_name("Small Gear");
         small_gear->set_description("A small but precisely crafted gear");
         small_gear->set_type("part");
         small_gear->set_location("clockwork_forge");
         game_world.add_item(small_gear);
 
-        auto amulet = std::make_shared<item>("echo_amulet");
+        auto amulet = game_world.create_item(symbol("echo_amulet"));
         amulet->set_name("Echo Amulet");
         amulet->set_description("Allows glimpses into past events");
         amulet->set_type("artifact");
         amulet->set_location("skyward_nexus");
         game_world.add_item(amulet);
 
-        auto gauge = std::make_shared<item>("pressure_gauge");
+        auto gauge = game_world.create_item(symbol("pressure_gauge"));
         gauge->set_name("Pressure Gauge");
         gauge->set_description("A device for measuring underwater pressure");
         gauge->set_type("tool");
@@ -195,7 +236,7 @@ void game_engine::initialize() {
         game_world.add_item(gauge);
 
         for (int i = 1; i <= 5; i++) {
-            auto fragment = std::make_shared<item>("crystal_fragment_" + std::to_string(i));
+            auto fragment = game_world.create_item(symbol("crystal_fragment_" + std::to_string(i)));
             fragment->set_name("Crystal Fragment " + std::to_string(i));
             fragment->set_description("A glowing fragment of the Echo Crystal");
             fragment->set_type("quest_item");
@@ -217,38 +258,58 @@ void game_engine::initialize() {
         game_world.set_player_inventory_size(10);
     }
 
-    player_character.set_current_room(game_world.get_starting_room());
-    player_character.set_inventory_size(game_world.get_player_inventory_size());
-
-    for (const auto& item_id : game_world.get_starting_inventory()) {
-        const auto& item = game_world.get_item(item_id);
-        if (item) {
-            player_character.add_to_inventory(item);
-        }
+    if (!game_world.get_scripts()) {
+        loader.load_scripts(default_scripts, game_world);
     }
 
-    player_character.set_health(game_world.get_player_health());
     fix_game_paths_and_fragments();
-    print_introduction();
+    game_world.build_name_indexes();
 }
 
 void game_engine::run() {
-    std::cout << game_world.get_room_description(player_character.get_current_room(), true) << std::endl;
+    start();
 
     std::string command;
     while (game_running) {
         std::cout << "> ";
-        std::getline(std::cin, command);
+        if (!std::getline(std::cin, command)) {
+            break;
+        }
 
         if (command.empty()) {
             continue;
         }
 
-        process_command(command);
-        update_npcs(); 
+        handle_command(command);
     }
 }
 
+void game_engine::start() {
+    std::cout << game_world.get_room_description(player_character.get_current_room(), true) << std::endl;
+}
+
+void game_engine::handle_command(const std::string& command) {
+    process_command(command);
+    update_npcs();
+    game_world.trim_rooms();
+    game_world.build_name_indexes();
+
+    if (journal.is_open() && !journal.commit(game_world, player_character)) {
+        std::cout << "Error: Autosave failed." << std::endl;
+        set_autosave("");
+    }
+}
+
+bool game_engine::is_running() const {
+    return game_running;
+}
+
+void game_engine::print_welcome() const {
+    std::cout << "Welcome to The Labyrinth of Echoes!\n";
+    std::cout << "A fractured realm where ancient magic and steampunk technology coexist.\n";
+    std::cout << "Type 'help' for a list of commands.\n\n";
+}
+
 void game_engine::fix_game_paths_and_fragments() {
     auto nexus = game_world.get_room("skyward_nexus");
     if (nexus) {
@@ -267,13 +328,14 @@ void game_engine::fix_game_paths_and_fragments() {
 
     auto ember_peaks = game_world.get_room("ember_peaks");
     if (!ember_peaks) {
-        ember_peaks = std::make_shared<room>("ember_peaks");
+        auto created = game_world.create_room(symbol("ember_peaks"));
+        ember_peaks = created.get();
         ember_peaks->set_name("Ember Peaks");
         ember_peaks->set_type("combat_area");
         ember_peaks->set_short_description("The burning peaks");
         ember_peaks->set_long_description("Rivers of lava flow between crystalline formations. The air shimmers with heat, and ancient forges glow in the depths.");
         ember_peaks->add_connection("west", "skyward_nexus");
-        game_world.add_room(ember_peaks);
+        game_world.add_room(created);
     }
     else {
         ember_peaks->add_connection("west", "skyward_nexus");
@@ -281,14 +343,15 @@ void game_engine::fix_game_paths_and_fragments() {
 
     auto abyssal = game_world.get_room("abyssal_trench");
     if (!abyssal) {
-        abyssal = std::make_shared<room>("abyssal_trench");
+        auto created = game_world.create_room(symbol("abyssal_trench"));
+        abyssal = created.get();
         abyssal->set_name("Abyssal Trench");
         abyssal->set_type("underwater_area");
         abyssal->set_short_description("The dark depths");
         abyssal->set_long_description("Crystal-clear waters reveal ancient ruins below. Strange creatures dart through the depths, and forgotten treasures glitter in the dark.");
         abyssal->add_connection("up", "skyward_nexus");
         abyssal->add_connection("east", "echo_chamber");
-        game_world.add_room(abyssal);
+        game_world.add_room(created);
     }
     else {
         abyssal->add_connection("up", "skyward_nexus");
@@ -297,7 +360,8 @@ void game_engine::fix_game_paths_and_fragments() {
 
     auto chamber = game_world.get_room("echo_chamber");
     if (!chamber) {
-        chamber = std::make_shared<room>("echo_chamber");
+        auto created = game_world.create_room(symbol("echo_chamber"));
+        chamber = created.get();
         chamber->set_name("Echo Chamber");
         chamber->set_type("final_area");
         chamber->set_short_description("The crystal chamber");
@@ -305,23 +369,23 @@ void game_engine::fix_game_paths_and_fragments() {
         chamber->add_feature("crystal_altar");
         chamber->add_feature("reality_rifts");
         chamber->add_connection("west", "abyssal_trench");
-        game_world.add_room(chamber);
+        game_world.add_room(created);
     }
     else {
         chamber->add_connection("west", "abyssal_trench");
     }
 
     bool architect_exists = false;
-    for (auto& npc : game_world.get_npcs()) {
-        if (npc->get_id() == "architect") {
-            npc->set_current_room("echo_chamber");
+    for (auto& npc_entry : game_world.get_npcs()) {
+        if (npc_entry.get_id() == "architect") {
+            npc_entry.set_current_room("echo_chamber");
             architect_exists = true;
             break;
         }
     }
 
     if (!architect_exists) {
-        auto architect = std::make_shared<npc>("architect");
+        auto architect = game_world.create_npc("architect");
         architect->set_name("The Architect");
         architect->set_description("A mysterious figure who appears in visions");
         architect->set_role("Mysterious Figure");
@@ -331,7 +395,7 @@ void game_engine::fix_game_paths_and_fragments() {
 
     auto fragment3 = game_world.get_item("crystal_fragment_3");
     if (!fragment3) {
-        auto new_fragment = std::make_shared<item>("crystal_fragment_3");
+        auto new_fragment = game_world.create_item(symbol("crystal_fragment_3"));
         new_fragment->set_name("Crystal Fragment 3");
         new_fragment->set_description("A glowing fragment of the Echo Crystal.");
         new_fragment->set_type("quest_item");
@@ -344,7 +408,7 @@ void game_engine::fix_game_paths_and_fragments() {
 
     auto fragment4 = game_world.get_item("crystal_fragment_4");
     if (!fragment4) {
-        auto new_fragment = std::make_shared<item>("crystal_fragment_4");
+        auto new_fragment = game_world.create_item(symbol("crystal_fragment_4"));
         new_fragment->set_name("Crystal Fragment 4");
         new_fragment->set_description("A glowing fragment of the Echo Crystal.");
         new_fragment->set_type("quest_item");
@@ -389,9 +453,9 @@ void game_engine::hide_fragments_until_puzzles_solved() {
 }
 
 void game_engine::process_command(const std::string& command) {
-    std::string lower_command = command;
-    std::transform(lower_command.begin(), lower_command.end(), lower_command.begin(),
-        [](unsigned char c) { return std::tolower(c); });
+    command_buffer.assign(command);
+    parser::normalize(command_buffer);
+    const std::string& lower_command = command_buffer;
 
     if (lower_command == "quit" || lower_command == "exit") {
         std::cout << "Are you sure you want to quit? (y/n): ";
@@ -415,6 +479,13 @@ void game_engine::process_command(const std::string& command) {
         }
         return;
     }
+    else if (lower_command == "autosave") {
+        std::cout << "Enter autosave file name (blank to stop): ";
+        std::string filename;
+        std::getline(std::cin, filename);
+        set_autosave(filename);
+        return;
+    }
     else if (lower_command == "load") {
         std::cout << "Enter save file name to load: ";
         std::string filename;
@@ -433,31 +504,22 @@ void game_engine::process_command(const std::string& command) {
         return;
     }
 
-    std::string verb, object;
-    command_parser.parse_command(lower_command, verb, object);
-
-    if (verb == "n" || verb == "north" || verb == "s" || verb == "south" ||
-        verb == "e" || verb == "east" || verb == "w" || verb == "west" ||
-        verb == "up" || verb == "down") {
-        std::string direction;
-        if (verb == "n" || verb == "north") direction = "north";
-        else if (verb == "s" || verb == "south") direction = "south";
-        else if (verb == "e" || verb == "east") direction = "east";
-        else if (verb == "w" || verb == "west") direction = "west";
-        else if (verb == "up") direction = "up";
-        else if (verb == "down") direction = "down";
+    parsed_command parsed;
+    command_parser.parse_command(lower_command, parsed);
 
+    exit_direction direction;
+    if (parse_exit_direction(parsed.verb, direction)) {
         game_world.move_player(player_character, direction);
         return;
     }
 
-    bool success = command_parser.execute_command(verb, object, player_character, game_world);
+    bool success = command_parser.execute_command(parsed.verb, parsed.object, player_character, game_world);
     if (!success) {
-        if (object.empty()) {
-            std::cout << "Sorry, I don't know the verb \"" << verb << "\"." << std::endl;
+        if (parsed.object.empty()) {
+            std::cout << "Sorry, I don't know the verb \"" << parsed.verb << "\"." << std::endl;
         }
         else {
-            std::cout << "I don't understand \"" << verb << " " << object << "\"." << std::endl;
+            std::cout << "I don't understand \"" << parsed.verb << " " << parsed.object << "\"." << std::endl;
         }
     }
 }
@@ -467,7 +529,7 @@ void game_engine::print_help() const {
     std::cout << "  Movement: north/n, south/s, east/e, west/w, up, down\n";
     std::cout << "  Actions: look, inventory/i, take [item], drop [item], use [item], examine [item/npc]\n";
     std::cout << "           talk [npc], read [item], activate [item]\n";
-    std::cout << "  Game: help, save, load, quit/exit\n";
+    std::cout << "  Game: help, save, load, autosave, quit/exit\n";
 }
 
 void game_engine::print_introduction() const {
@@ -487,41 +549,54 @@ void game_engine::update_npcs() {
 }
 
 void game_engine::save_game(const std::string& filename) const {
-    std::ofstream out_file(filename);
-    if (!out_file) {
+    if (!world_snapshot::save(filename, game_world, player_character)) {
         std::cout << "Error: Could not create save file." << std::endl;
         return;
     }
 
-    out_file << "PLAYER\n";
-    out_file << player_character.get_current_room() << "\n";
-    out_file << player_character.get_health() << "\n";
+    std::cout << "Game saved to " << filename << "." << std::endl;
+}
 
-    out_file << "INVENTORY\n";
-    const auto& inventory = player_character.get_inventory();
-    out_file << inventory.size() << "\n";
-    for (const auto& item : inventory) {
-        out_file << item->get_id() << "\n";
+void game_engine::load_game(const std::string& filename) {
+    command_parser.forget_references();
+    if (world_snapshot::is_snapshot(filename)) {
+        uint32_t generation = 0;
+        if (!world_snapshot::load(filename, game_world, player_character, &generation)) {
+            std::cout << "Error: Could not read save file." << std::endl;
+            return;
+        }
+
+        if (generation != 0) {
+            world_journal::replay(filename, generation, game_world, player_character);
+        }
+
+        std::cout << "Game loaded from " << filename << "." << std::endl;
+        std::cout << game_world.get_room_description(player_character.get_current_room(), true) << std::endl;
+        return;
     }
 
-    out_file << "FLAGS\n";
-    const auto& flags = game_world.get_game_flags();
-    out_file << flags.size() << "\n";
-    for (const auto& flag_pair : flags) {
-        out_file << flag_pair.first << " " << flag_pair.second << "\n";
+    load_text_game(filename);
+}
+
+void game_engine::set_autosave(const std::string& filename) {
+    if (filename.empty()) {
+        game_world.set_journal(nullptr);
+        journal.close();
+        std::cout << "Autosave disabled." << std::endl;
+        return;
     }
 
-    out_file << "NPCS\n";
-    const auto& npcs = game_world.get_npcs();
-    out_file << npcs.size() << "\n";
-    for (const auto& npc : npcs) {
-        out_file << npc->get_id() << " " << npc->get_current_room() << " " << npc->get_state() << "\n";
+    game_world.set_journal(nullptr);
+    if (!journal.open(filename, game_world, player_character)) {
+        std::cout << "Error: Could not create save file." << std::endl;
+        return;
     }
 
-    std::cout << "Game saved to " << filename << "." << std::endl;
+    game_world.set_journal(&journal);
+    std::cout << "Autosaving to " << filename << "." << std::endl;
 }
 
-void game_engine::load_game(const std::string& filename) {
+void game_engine::load_text_game(const std::string& filename) {
     std::ifstream in_file(filename);
     if (!in_file) {
         std::cout << "Error: Could not open save file." << std::endl;
@@ -579,6 +654,22 @@ void game_engine::load_game(const std::string& filename) {
         game_world.update_npc_state(npc_id, npc_room, npc_state);
     }
 
+    if (std::getline(in_file, line) && line == "PUZZLES" && std::getline(in_file, line)) {
+        int puzzle_count = std::stoi(line);
+
+        for (int i = 0; i < puzzle_count; i++) {
+            std::getline(in_file, line);
+            std::istringstream iss(line);
+            std::string room_id, puzzle_id;
+            uint32_t puzzle_state = 0;
+            iss >> room_id >> puzzle_id >> puzzle_state;
+            auto room_ptr = game_world.get_room(room_id);
+            if (room_ptr) {
+                room_ptr->set_puzzle_state(symbol(puzzle_id), puzzle_state);
+            }
+        }
+    }
+
     std::cout << "Game loaded from " << filename << "." << std::endl;
     std::cout << game_world.get_room_description(player_character.get_current_room(), true) << std::endl;
 }
@@ -4,6 +4,7 @@
 #include "../world/world.hpp"
 #include "../parser/parser.hpp"
 #include "../player/player.hpp"
+#include "../snapshot/world_journal.hpp"
 #include "../includes.hpp"
 #include <string>
 #include <vector>
@@ -11,23 +12,38 @@
 
 class game_engine {
 private:
+    static const size_t room_budget = 64 * 1024 * 1024;
+
+    std::shared_ptr<const world> world_template;
     world game_world;
     parser command_parser;
+    std::string command_buffer;
     player player_character;
     bool game_running;
     std::string config_path;
+    world_journal journal;
 
+    void load_world();
     void fix_game_paths_and_fragments();
     void hide_fragments_until_puzzles_solved();
     void process_command(const std::string& command);
     void print_help() const;
     void print_introduction() const;
     void update_npcs();
+    void load_text_game(const std::string& filename);
+    void set_autosave(const std::string& filename);
 
 public:
     game_engine();
+    explicit game_engine(std::shared_ptr<const world> shared_world);
+    static std::shared_ptr<const world> load_world_template(const std::string& path = "game_config.json");
+
     void initialize();
     void run();
+    void start();
+    void handle_command(const std::string& command);
+    bool is_running() const;
+    void print_welcome() const;
     void save_game(const std::string& filename) const;
     void load_game(const std::string& filename);
 };
@@ -1,76 +1,171 @@
 #include "item.hpp"
+#include "../world/location_index.hpp"
+#include "../world/item_columns.hpp"
 #include <iostream>
+#include <algorithm>
 
-item::item(const std::string& item_id) : id(item_id) {}
+static const symbol readable_property = symbol_table::intern("readable");
+static const symbol contents_property = symbol_table::intern("contents");
+
+item::item(const std::string& item_id) : item(symbol_table::intern(item_id)) {}
+
+item::item(symbol item_id) : item(item_id, std::make_shared<item_content>()) {}
+
+item::item(symbol item_id, std::shared_ptr<item_content> initial_content) :
+    id(item_id), match_id(symbol_table::intern(to_lower(item_id.str()))), content(std::move(initial_content)), index(nullptr), columns(nullptr), row(0) {}
+
+item_content& item::edit_content() {
+    if (content.use_count() > 1) {
+        content = std::make_shared<item_content>(*content);
+    }
+    return *content;
+}
 
 void item::set_name(const std::string& item_name) {
-    name = item_name;
+    item_content& edited = edit_content();
+    edited.name = item_name;
+    edited.match_name = symbol_table::intern(to_lower(item_name));
+    if (columns) {
+        columns->set_name(row, symbol_table::intern(item_name));
+    }
 }
 
-std::string item::get_name() const {
-    return name;
+const std::string& item::get_name() const {
+    return content->name;
 }
 
 void item::set_description(const std::string& desc) {
-    description = desc;
+    edit_content().description = desc;
 }
 
-std::string item::get_description() const {
-    return description;
+const std::string& item::get_description() const {
+    return content->description;
 }
 
 void item::set_type(const std::string& item_type) {
-    type = item_type;
+    edit_content().type = item_type;
+    if (columns) {
+        columns->set_type(row, symbol_table::intern(item_type));
+    }
+}
+
+const std::string& item::get_type() const {
+    return content->type;
 }
 
-std::string item::get_type() const {
-    return type;
+const std::string& item::get_id() const {
+    return id.str();
 }
 
-std::string item::get_id() const {
+symbol item::get_id_symbol() const {
     return id;
 }
 
+const std::string& item::get_match_name() const {
+    return content->match_name.str();
+}
+
+const std::string& item::get_match_id() const {
+    return match_id.str();
+}
+
 void item::set_location(const std::string& loc) {
+    set_location(symbol_table::intern(loc));
+}
+
+void item::set_location(symbol loc) {
+    if (index) {
+        index->relocate(this, location, loc);
+    }
+    if (columns) {
+        columns->set_location(row, loc);
+    }
     location = loc;
 }
 
-std::string item::get_location() const {
+const std::string& item::get_location() const {
+    return location.str();
+}
+
+symbol item::get_location_symbol() const {
     return location;
 }
 
-void item::set_property(const std::string& key, const std::string& value) {
-    properties[key] = value;
+void item::set_location_index(location_index* owner) {
+    index = owner;
 }
 
-std::string item::get_property(const std::string& key) const {
-    auto it = properties.find(key);
+void item::set_columns(item_columns* owner, std::uint32_t owner_row) {
+    columns = owner;
+    row = owner_row;
+}
+
+void item::set_property(const std::string& key, property_value value) {
+    set_property(symbol_table::intern(key), std::move(value));
+}
+
+void item::set_property(symbol key, property_value value) {
+    bool flag = value.as_bool();
+    auto& properties = edit_content().properties;
+    auto it = std::find_if(properties.begin(), properties.end(),
+        [key](const auto& entry) { return entry.first == key; });
     if (it != properties.end()) {
-        return it->second;
+        it->second = std::move(value);
     }
-    return "";
+    else {
+        properties.emplace_back(key, std::move(value));
+    }
+
+    if (columns) {
+        columns->set_flag(row, key, flag);
+    }
+}
+
+const property_value* item::find_property(symbol key) const {
+    for (const auto& entry : content->properties) {
+        if (entry.first == key) {
+            return &entry.second;
+        }
+    }
+    return nullptr;
+}
+
+bool item::get_flag(symbol key) const {
+    const property_value* value = find_property(key);
+    return value && value->as_bool();
+}
+
+std::string item::get_property(const std::string& key) const {
+    symbol key_symbol;
+    if (!symbol_table::lookup(key, key_symbol)) {
+        return "";
+    }
+
+    const property_value* value = find_property(key_symbol);
+    return value ? value->to_string() : "";
 }
 
-const std::unordered_map<std::string, std::string>& item::get_properties() const {
-    return properties;
+const item_properties& item::get_properties() const {
+    return content->properties;
 }
 
-bool item::use(const std::string& target) {
-    std::cout << "You can't use the " << name << " that way." << std::endl;
+bool item::use(std::string_view) {
+    std::cout << "You can't use the " << content->name << " that way." << std::endl;
     return false;
 }
 
 bool item::read() {
-    if (get_property("readable") == "true") {
-        std::cout << get_property("contents") << std::endl;
+    if (get_flag(readable_property)) {
+        const property_value* contents = find_property(contents_property);
+        std::cout << (contents ? contents->to_string() : "") << std::endl;
         return true;
     }
     else {
-        std::cout << "You can't read the " << name << "." << std::endl;
+        std::cout << "You can't read the " << content->name << "." << std::endl;
         return false;
     }
 }
 
 std::string item::examine() const {
-    return description;
+    return content->description;
 }
@@ -1,42 +1,74 @@
 #ifndef ITEM_HPP
 #define ITEM_HPP
 
+#include "item_property.hpp"
+#include "../symbol/symbol_table.hpp"
 #include "../includes.hpp"
 #include <string>
+#include <string_view>
 #include <vector> 
-#include <unordered_map>
+#include <memory>
+#include <cstdint>
 
-class item {
-private:
-    std::string id;
+class location_index;
+class item_columns;
+
+struct item_content {
     std::string name;
+    symbol match_name;
     std::string description;
     std::string type;
-    std::string location; 
-    std::unordered_map<std::string, std::string> properties;
+    item_properties properties;
+};
+
+class item {
+private:
+    symbol id;
+    symbol match_id;
+    std::shared_ptr<item_content> content;
+    symbol location; 
+    location_index* index;
+    item_columns* columns;
+    std::uint32_t row;
+
+    item_content& edit_content();
 
 public:
     item(const std::string& item_id);
+    item(symbol item_id);
+    item(symbol item_id, std::shared_ptr<item_content> initial_content);
 
     void set_name(const std::string& item_name);
-    std::string get_name() const;
+    const std::string& get_name() const;
 
     void set_description(const std::string& desc);
-    std::string get_description() const;
+    const std::string& get_description() const;
 
     void set_type(const std::string& item_type);
-    std::string get_type() const;
+    const std::string& get_type() const;
+
+    const std::string& get_id() const;
+    symbol get_id_symbol() const;
 
-    std::string get_id() const;
+    // Interned lowercase forms; set_name keeps match_name in step.
+    const std::string& get_match_name() const;
+    const std::string& get_match_id() const;
 
     void set_location(const std::string& loc);
-    std::string get_location() const;
+    void set_location(symbol loc);
+    const std::string& get_location() const;
+    symbol get_location_symbol() const;
+    void set_location_index(location_index* owner);
+    void set_columns(item_columns* owner, std::uint32_t owner_row);
 
-    void set_property(const std::string& key, const std::string& value);
+    void set_property(const std::string& key, property_value value);
+    void set_property(symbol key, property_value value);
+    const property_value* find_property(symbol key) const;
+    bool get_flag(symbol key) const;
     std::string get_property(const std::string& key) const;
-    const std::unordered_map<std::string, std::string>& get_properties() const;
+    const item_properties& get_properties() const;
 
-    bool use(const std::string& target);
+    bool use(std::string_view target);
     bool read();
     std::string examine() const;
 };
@@ -0,0 +1,107 @@
+#include "item_property.hpp"
+#include <charconv>
+
+property_kind property_value::kind() const {
+    return static_cast<property_kind>(value.index());
+}
+
+bool property_value::as_bool() const {
+    switch (kind()) {
+    case property_kind::boolean:
+        return std::get<bool>(value);
+    case property_kind::integer:
+        return std::get<std::int64_t>(value) != 0;
+    case property_kind::text:
+        return std::get<std::string>(value) == "true";
+    default:
+        return false;
+    }
+}
+
+std::int64_t property_value::as_int() const {
+    switch (kind()) {
+    case property_kind::boolean:
+        return std::get<bool>(value) ? 1 : 0;
+    case property_kind::integer:
+        return std::get<std::int64_t>(value);
+    case property_kind::number:
+        return static_cast<std::int64_t>(std::get<double>(value));
+    default:
+        return 0;
+    }
+}
+
+double property_value::as_number() const {
+    if (kind() == property_kind::number) {
+        return std::get<double>(value);
+    }
+    return static_cast<double>(as_int());
+}
+
+std::string property_value::to_string() const {
+    switch (kind()) {
+    case property_kind::boolean:
+        return std::get<bool>(value) ? "true" : "false";
+    case property_kind::integer:
+        return std::to_string(std::get<std::int64_t>(value));
+    case property_kind::number: {
+        char buffer[32];
+        auto result = std::to_chars(buffer, buffer + sizeof(buffer), std::get<double>(value));
+        return std::string(buffer, result.ptr);
+    }
+    case property_kind::text:
+        return std::get<std::string>(value);
+    case property_kind::list: {
+        std::string combined;
+        for (const auto& element : std::get<list_type>(value)) {
+            if (!combined.empty()) combined += ",";
+            combined += element;
+        }
+        return combined;
+    }
+    default:
+        return "";
+    }
+}
+
+const property_value::list_type* property_value::as_list() const {
+    return std::get_if<list_type>(&value);
+}
+
+property_value property_value::parse(property_kind kind, std::string_view text) {
+    switch (kind) {
+    case property_kind::boolean:
+        return property_value(text == "true");
+    case property_kind::integer: {
+        std::int64_t number = 0;
+        std::from_chars(text.data(), text.data() + text.size(), number);
+        return property_value(number);
+    }
+    case property_kind::number: {
+        double number = 0;
+        std::from_chars(text.data(), text.data() + text.size(), number);
+        return property_value(number);
+    }
+    case property_kind::text:
+        return property_value(std::string(text));
+    case property_kind::list: {
+        list_type items;
+        size_t start = 0;
+        while (!text.empty() && start <= text.size()) {
+            size_t end = text.find(',', start);
+            if (end == std::string_view::npos) {
+                end = text.size();
+            }
+            items.emplace_back(text.substr(start, end - start));
+            start = end + 1;
+        }
+        return property_value(std::move(items));
+    }
+    default:
+        return property_value();
+    }
+}
+
+bool property_value::operator==(const property_value& other) const {
+    return value == other.value;
+}
@@ -0,0 +1,56 @@
+#ifndef ITEM_PROPERTY_HPP
+#define ITEM_PROPERTY_HPP
+
+#include "../symbol/symbol_table.hpp"
+#include "../includes.hpp"
+#include <string>
+#include <string_view>
+#include <vector>
+#include <variant>
+#include <cstdint>
+#include <utility>
+
+enum class property_kind : uint8_t {
+    none,
+    boolean,
+    integer,
+    number,
+    text,
+    list
+};
+
+// Item property held in its parsed form. Scalars live inline in the
+// variant, so flag and counter checks never touch a string.
+class property_value {
+public:
+    using list_type = std::vector<std::string>;
+
+private:
+    std::variant<std::monostate, bool, std::int64_t, double, std::string, list_type> value;
+
+public:
+    property_value() = default;
+    property_value(bool flag) : value(flag) {}
+    property_value(int number) : value(static_cast<std::int64_t>(number)) {}
+    property_value(std::int64_t number) : value(number) {}
+    property_value(double number) : value(number) {}
+    property_value(const char* text) : value(std::string(text)) {}
+    property_value(std::string text) : value(std::move(text)) {}
+    property_value(list_type items) : value(std::move(items)) {}
+
+    property_kind kind() const;
+
+    bool as_bool() const;
+    std::int64_t as_int() const;
+    double as_number() const;
+    std::string to_string() const;
+    const list_type* as_list() const;
+
+    static property_value parse(property_kind kind, std::string_view text);
+
+    bool operator==(const property_value& other) const;
+};
+
+using item_properties = std::vector<std::pair<symbol, property_value>>;
+
+#endif
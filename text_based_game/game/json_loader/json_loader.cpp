@@ -1,6 +1,10 @@
 #include "json_loader.hpp"
+#include "../thread_pool/thread_pool.hpp"
 #include <fstream>
 #include <iostream>
+#include <functional>
+#include <vector>
+#include <deque>
 
 std::string get_string(const json& j, const std::string& key, const std::string& default_value = "") {
     if (j.contains(key) && j[key].is_string()) {
@@ -16,6 +20,40 @@ int get_int(const json& j, const std::string& key, int default_value = 0) {
     return default_value;
 }
 
+property_value get_property_value(const json& value) {
+    if (value.is_boolean()) {
+        return value.get<bool>();
+    }
+    else if (value.is_number_integer()) {
+        return value.get<std::int64_t>();
+    }
+    else if (value.is_number()) {
+        return value.get<double>();
+    }
+    else if (value.is_string()) {
+        return value.get<std::string>();
+    }
+    else if (value.is_array()) {
+        property_value::list_type items;
+        for (const auto& elem : value) {
+            if (elem.is_string()) {
+                items.push_back(elem.get<std::string>());
+            }
+            else if (elem.is_number()) {
+                items.push_back(std::to_string(elem.get<int>()));
+            }
+            else if (elem.is_boolean()) {
+                items.push_back(elem.get<bool>() ? "true" : "false");
+            }
+            else {
+                items.push_back("unknown");
+            }
+        }
+        return items;
+    }
+    return property_value();
+}
+
 bool get_bool(const json& j, const std::string& key, bool default_value = false) {
     if (j.contains(key)) {
         if (j[key].is_boolean()) {
@@ -28,6 +66,157 @@ bool get_bool(const json& j, const std::string& key, bool default_value = false)
     return default_value;
 }
 
+namespace {
+    const size_t entity_batch_size = 64;
+
+    enum class entity_kind {
+        room,
+        item,
+        npc
+    };
+
+    // Streams a game file through the SAX interface, materializing only one
+    // entity or section subtree at a time. Each completed subtree is handed to
+    // the capture callback together with its key path and then released.
+    // Object keys are interned here, in file order, so symbol numbering does
+    // not depend on how entity construction is scheduled.
+    class content_stream : public nlohmann::json_sax<json> {
+    public:
+        using capture_handler = std::function<void(const std::vector<std::string>&, json&)>;
+
+    private:
+        std::vector<std::vector<std::string>> capture_paths;
+        capture_handler on_capture;
+        std::vector<std::string> keys;
+        std::vector<bool> in_array;
+        std::string pending_key;
+        std::vector<std::string> capture_path;
+        json captured;
+        std::vector<json*> capture_stack;
+        std::string capture_key;
+
+        bool capturing() const {
+            return !capture_stack.empty();
+        }
+
+        bool matches_capture() {
+            if (keys.empty() || in_array.back()) {
+                return false;
+            }
+
+            size_t depth = keys.size();
+            for (const auto& path : capture_paths) {
+                if (path.size() != depth) {
+                    continue;
+                }
+
+                bool match = true;
+                for (size_t i = 0; match && i < depth; ++i) {
+                    const std::string& actual = i + 1 < depth ? keys[i + 1] : pending_key;
+                    match = path[i].empty() || path[i] == actual;
+                }
+
+                if (match) {
+                    capture_path.assign(keys.begin() + 1, keys.end());
+                    capture_path.push_back(pending_key);
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        json* store(json&& value) {
+            json& parent = *capture_stack.back();
+            if (parent.is_array()) {
+                parent.push_back(std::move(value));
+                return &parent.back();
+            }
+            json& slot = parent[capture_key];
+            slot = std::move(value);
+            return &slot;
+        }
+
+        bool scalar(json&& value) {
+            if (capturing()) {
+                store(std::move(value));
+            }
+            return true;
+        }
+
+        bool start_container(json&& value) {
+            if (capturing()) {
+                capture_stack.push_back(store(std::move(value)));
+            }
+            else if (value.is_object() && matches_capture()) {
+                captured = std::move(value);
+                capture_stack.push_back(&captured);
+            }
+            else {
+                keys.push_back(in_array.empty() || !in_array.back() ? pending_key : std::string());
+                in_array.push_back(value.is_array());
+            }
+            return true;
+        }
+
+        bool end_container() {
+            if (!capturing()) {
+                keys.pop_back();
+                in_array.pop_back();
+                return true;
+            }
+
+            capture_stack.pop_back();
+            if (!capturing()) {
+                on_capture(capture_path, captured);
+                captured = json();
+            }
+            return true;
+        }
+
+    public:
+        content_stream(std::vector<std::vector<std::string>> paths, capture_handler handler) :
+            capture_paths(std::move(paths)), on_capture(std::move(handler)) {}
+
+        bool null() override { return scalar(json()); }
+        bool boolean(bool value) override { return scalar(json(value)); }
+        bool number_integer(number_integer_t value) override { return scalar(json(value)); }
+        bool number_unsigned(number_unsigned_t value) override { return scalar(json(value)); }
+        bool number_float(number_float_t value, const string_t&) override { return scalar(json(value)); }
+        bool string(string_t& value) override { return scalar(json(std::move(value))); }
+        bool binary(binary_t& value) override { return scalar(json(std::move(value))); }
+
+        bool start_object(std::size_t) override { return start_container(json::object()); }
+        bool end_object() override { return end_container(); }
+        bool start_array(std::size_t) override { return start_container(json::array()); }
+        bool end_array() override { return end_container(); }
+
+        bool key(string_t& value) override {
+            symbol_table::intern(value);
+            if (capturing()) {
+                capture_key = value;
+            }
+            else {
+                pending_key = value;
+            }
+            return true;
+        }
+
+        bool parse_error(std::size_t position, const std::string&, const nlohmann::detail::exception& error) override {
+            std::cerr << "Failed to parse game data at byte " << position << ": " << error.what() << std::endl;
+            return false;
+        }
+    };
+}
+
+struct json_loader::pending_entity {
+    entity_kind kind;
+    std::string id;
+    json data;
+    std::shared_ptr<room> room_ptr = nullptr;
+    std::shared_ptr<item> item_ptr = nullptr;
+    std::shared_ptr<npc> npc_ptr = nullptr;
+};
+
 bool json_loader::load_game_data(const std::string& filename, world& game_world) {
     std::ifstream file(filename);
     if (!file.is_open()) {
@@ -35,61 +224,165 @@ bool json_loader::load_game_data(const std::string& filename, world& game_world)
         return false;
     }
 
-    json j;
-    file >> j;
+    // Rooms, items and NPCs are built as soon as their object closes; the
+    // small sections are kept and applied afterwards in their original order
+    // so the result does not depend on the key order in the file.
+    json game_config;
+    json world_state;
+    json player_data;
+    json quest_items;
+    json scripts_data;
+
+    // Entities are built in batches on worker threads and merged into the
+    // world afterwards in file order, so the result matches a serial load.
+    thread_pool workers;
+    std::deque<std::vector<pending_entity>> batches;
+    std::vector<pending_entity> current;
+    auto submit_batch = [&]() {
+        if (current.empty()) {
+            return;
+        }
+        auto& batch = batches.emplace_back(std::move(current));
+        current.clear();
+        workers.submit([this, &batch, &game_world] {
+            build_entities(batch, game_world);
+        });
+    };
+
+    content_stream stream({
+        { "game_config" },
+        { "world_state" },
+        { "characters", "player" },
+        { "characters", "npcs", "" },
+        { "items", "passive_items", "" },
+        { "items", "quest_items" },
+        { "locations", "" },
+        { "scripts" }
+    }, [&](const std::vector<std::string>& path, json& data) {
+        if (path[0] == "locations") {
+            current.push_back({ entity_kind::room, path[1], std::move(data) });
+        }
+        else if (path.size() == 3 && path[0] == "characters") {
+            current.push_back({ entity_kind::npc, path[2], std::move(data) });
+        }
+        else if (path.size() == 3 && path[0] == "items") {
+            current.push_back({ entity_kind::item, path[2], std::move(data) });
+        }
+        else if (path[0] == "game_config") {
+            game_config = std::move(data);
+        }
+        else if (path[0] == "world_state") {
+            world_state = std::move(data);
+        }
+        else if (path[0] == "characters") {
+            player_data = std::move(data);
+        }
+        else if (path[0] == "items") {
+            quest_items = std::move(data);
+        }
+        else if (path[0] == "scripts") {
+            scripts_data = std::move(data);
+        }
+
+        if (current.size() >= entity_batch_size) {
+            submit_batch();
+        }
+    });
+
+    bool parsed = json::sax_parse(file, &stream);
+    submit_batch();
+    workers.wait();
+    if (!parsed) {
+        return false;
+    }
 
-    if (j.contains("game_config") && j["game_config"].is_object()) {
-        load_game_config(j["game_config"], game_world);
+    for (const auto& batch : batches) {
+        for (const auto& entity : batch) {
+            if (entity.room_ptr) {
+                game_world.add_room(entity.room_ptr);
+            }
+            else if (entity.item_ptr) {
+                game_world.add_item(entity.item_ptr);
+            }
+            else if (entity.npc_ptr) {
+                game_world.add_npc(entity.npc_ptr);
+            }
+        }
     }
 
-    if (j.contains("world_state") && j["world_state"].is_object()) {
-        load_world_state(j["world_state"], game_world);
+    if (game_config.is_object()) {
+        load_game_config(game_config, game_world);
     }
 
-    if (j.contains("characters") && j["characters"].is_object() &&
-        j["characters"].contains("player") && j["characters"]["player"].is_object()) {
-        load_player(j["characters"]["player"], game_world);
+    if (world_state.is_object()) {
+        load_world_state(world_state, game_world);
     }
 
-    if (j.contains("characters") && j["characters"].is_object() &&
-        j["characters"].contains("npcs") && j["characters"]["npcs"].is_object()) {
-        load_npcs(j["characters"]["npcs"], game_world);
+    if (player_data.is_object()) {
+        load_player(player_data, game_world);
     }
 
-    if (j.contains("items") && j["items"].is_object()) {
-        load_items(j["items"], game_world);
+    if (quest_items.is_object()) {
+        load_quest_items(quest_items, game_world);
     }
 
-    if (j.contains("locations") && j["locations"].is_object()) {
-        load_rooms(j["locations"], game_world);
+    if (scripts_data.is_object()) {
+        script_source = scripts_data.dump();
+        load_script_rules(scripts_data, game_world);
     }
 
     return true;
 }
 
+void json_loader::build_entities(std::vector<pending_entity>& batch, const world& game_world) const {
+    for (auto& entity : batch) {
+        switch (entity.kind) {
+        case entity_kind::room:
+            entity.room_ptr = build_room(entity.id, entity.data, game_world);
+            break;
+        case entity_kind::item:
+            entity.item_ptr = build_item(entity.id, entity.data, game_world);
+            break;
+        case entity_kind::npc:
+            entity.npc_ptr = build_npc(entity.id, entity.data, game_world);
+            break;
+        }
+        entity.data = json();
+    }
+}
+
 void json_loader::load_game_config(const json& config, world& game_world) {
     game_world.set_world_name(config["title"]);
 
     if (config.contains("initial_state")) {
-        auto key = std::make_shared<item>("clockwork_key");
-        key->set_name("Clockwork Key");
-        key->set_description("A brass key used to operate steampunk machinery.");
-        key->set_type("key");
-        key->set_property("opens", "forge_door,mechanical_chest,airship_engine");
-        key->set_property("breakable", "false");
-        game_world.add_item(key);
-
-        auto compass = std::make_shared<item>("runed_compass");
-        compass->set_name("Runed Compass");
-        compass->set_description("Points toward hidden pathways");
-        compass->set_type("tool");
-        compass->set_property("reveals_secrets", "true");
-        compass->set_property("durability", "infinite");
-        compass->set_property("usable_in", "all_locations");
-        game_world.add_item(compass);
+        // Built-in items only fill gaps; entries from the items section were
+        // already streamed in and take precedence.
+        if (!game_world.get_item("clockwork_key")) {
+            auto key = game_world.create_item(symbol("clockwork_key"));
+            key->set_name("Clockwork Key");
+            key->set_description("A brass key used to operate steampunk machinery.");
+            key->set_type("key");
+            key->set_property("opens", property_value::list_type{ "forge_door", "mechanical_chest", "airship_engine" });
+            key->set_property("breakable", false);
+            game_world.add_item(key);
+        }
+
+        if (!game_world.get_item("runed_compass")) {
+            auto compass = game_world.create_item(symbol("runed_compass"));
+            compass->set_name("Runed Compass");
+            compass->set_description("Points toward hidden pathways");
+            compass->set_type("tool");
+            compass->set_property("reveals_secrets", true);
+            compass->set_property("durability", "infinite");
+            compass->set_property("usable_in", "all_locations");
+            game_world.add_item(compass);
+        }
 
         for (int i = 1; i <= 5; i++) {
-            auto fragment = std::make_shared<item>("crystal_fragment_" + std::to_string(i));
+            std::string fragment_id = "crystal_fragment_" + std::to_string(i);
+            if (game_world.get_item(fragment_id)) continue;
+
+            auto fragment = game_world.create_item(symbol(fragment_id));
             fragment->set_name("Crystal Fragment " + std::to_string(i));
             fragment->set_description("A glowing fragment of the Echo Crystal.");
             fragment->set_type("quest_item");
@@ -105,6 +398,7 @@ void json_loader::load_game_config(const json& config, world& game_world) {
         game_world.set_player_health(config["initial_state"]["player_health"]);
 
         for (const auto& [key, value] : config["initial_state"]["game_flags"].items()) {
+            game_world.declare_flag(symbol_table::intern(key));
             if (value.is_boolean()) {
                 game_world.set_game_flag(key, value);
             }
@@ -145,23 +439,18 @@ void json_loader::load_player(const json& player_data, world& game_world) {
     }
 }
 
-void json_loader::load_npcs(const json& npcs_data, world& game_world) {
-    for (const auto& [npc_id, npc_data] : npcs_data.items()) {
-        if (!npc_data.is_object()) continue;
-
-        auto npc_ptr = std::make_shared<npc>(npc_id);
-        npc_ptr->set_name(get_string(npc_data, "name", npc_id));
-        npc_ptr->set_description(get_string(npc_data, "description", "A mysterious figure."));
-        npc_ptr->set_role(get_string(npc_data, "role", "unknown"));
-        npc_ptr->set_current_room(get_string(npc_data, "initial_location", "sanctum_whispers"));
-
-        setup_npc_behaviors(npc_ptr, npc_data, game_world);
+std::shared_ptr<npc> json_loader::build_npc(const std::string& npc_id, const json& npc_data, const world& game_world) const {
+    auto npc_ptr = game_world.create_npc(npc_id);
+    npc_ptr->set_name(get_string(npc_data, "name", npc_id));
+    npc_ptr->set_description(get_string(npc_data, "description", "A mysterious figure."));
+    npc_ptr->set_role(get_string(npc_data, "role", "unknown"));
+    npc_ptr->set_current_room(get_string(npc_data, "initial_location", "sanctum_whispers"));
 
-        game_world.add_npc(npc_ptr);
-    }
+    setup_npc_behaviors(npc_ptr, npc_data);
+    return npc_ptr;
 }
 
-void json_loader::setup_npc_behaviors(std::shared_ptr<npc>& npc_ptr, const json& npc_data, world& game_world) {
+void json_loader::setup_npc_behaviors(std::shared_ptr<npc>& npc_ptr, const json& npc_data) const {
     std::string initial_state = "initial";
 
     if (npc_data.contains("states") && npc_data["states"].is_object()) {
@@ -185,7 +474,7 @@ void json_loader::setup_npc_behaviors(std::shared_ptr<npc>& npc_ptr, const json&
     npc_ptr->set_state(initial_state);
 }
 
-void json_loader::setup_dialogue(std::shared_ptr<npc>& npc_ptr, const std::string& state_name, const json& dialogue_data) {
+void json_loader::setup_dialogue(std::shared_ptr<npc>& npc_ptr, const std::string& state_name, const json& dialogue_data) const {
     for (const auto& [dialogue_id, dialogue_node_data] : dialogue_data.items()) {
         if (!dialogue_node_data.is_object()) continue;
 
@@ -224,162 +513,392 @@ void json_loader::setup_dialogue(std::shared_ptr<npc>& npc_ptr, const std::strin
     }
 }
 
-void json_loader::load_items(const json& items_data, world& game_world) {
-    if (items_data.contains("passive_items") && items_data["passive_items"].is_object()) {
-        for (const auto& [item_id, item_data] : items_data["passive_items"].items()) {
-            if (!item_data.is_object()) continue;
+std::shared_ptr<item> json_loader::build_item(const std::string& item_id, const json& item_data, const world& game_world) const {
+    auto item_ptr = game_world.create_item(symbol(item_id));
 
-            auto item_ptr = std::make_shared<item>(item_id);
+    item_ptr->set_name(get_string(item_data, "name", item_id));
+    item_ptr->set_description(get_string(item_data, "description", "A mysterious item."));
+    item_ptr->set_type(get_string(item_data, "type", "misc"));
 
-            item_ptr->set_name(get_string(item_data, "name", item_id));
-            item_ptr->set_description(get_string(item_data, "description", "A mysterious item."));
-            item_ptr->set_type(get_string(item_data, "type", "misc"));
+    if (item_data.contains("properties") && item_data["properties"].is_object()) {
+        for (const auto& [key, value] : item_data["properties"].items()) {
+            if (value.is_null() || value.is_boolean() || value.is_number() || value.is_string() || value.is_array()) {
+                item_ptr->set_property(key, get_property_value(value));
+            }
+        }
+    }
 
-            if (item_data.contains("properties") && item_data["properties"].is_object()) {
-                for (const auto& [key, value] : item_data["properties"].items()) {
-                    if (value.is_null()) {
-                        item_ptr->set_property(key, "");
-                    }
-                    else if (value.is_boolean()) {
-                        item_ptr->set_property(key, value.get<bool>() ? "true" : "false");
-                    }
-                    else if (value.is_number()) {
-                        item_ptr->set_property(key, std::to_string(value.get<int>()));
-                    }
-                    else if (value.is_string()) {
-                        item_ptr->set_property(key, value.get<std::string>());
-                    }
-                    else if (value.is_array()) {
-                        std::string combined;
-                        for (const auto& elem : value) {
-                            if (!combined.empty()) combined += ",";
-                            if (elem.is_string()) {
-                                combined += elem.get<std::string>();
-                            }
-                            else if (elem.is_number()) {
-                                combined += std::to_string(elem.get<int>());
-                            }
-                            else if (elem.is_boolean()) {
-                                combined += elem.get<bool>() ? "true" : "false";
-                            }
-                            else {
-                                combined += "unknown";
-                            }
-                        }
-                        item_ptr->set_property(key, combined);
-                    }
-                }
+    return item_ptr;
+}
+
+void json_loader::load_quest_items(const json& quest_items, world& game_world) {
+    if (quest_items.contains("crystal_fragments") && quest_items["crystal_fragments"].is_object()) {
+        for (const auto& [fragment_id, fragment_data] : quest_items["crystal_fragments"].items()) {
+            if (!fragment_data.is_object()) continue;
+
+            std::string item_id = "crystal_fragment_";
+            if (fragment_id.length() > 0) {
+                item_id += fragment_id.back();
+            }
+            else {
+                continue;
+            }
+
+            auto item_ptr = game_world.get_item(item_id);
+            if (!item_ptr) {
+                auto created = game_world.create_item(symbol(item_id));
+                item_ptr = created.get();
+                item_ptr->set_name("Crystal Fragment");
+                item_ptr->set_description("A glowing fragment of the Echo Crystal.");
+                item_ptr->set_type("quest_item");
+                game_world.add_item(created);
             }
 
-            game_world.add_item(item_ptr);
+            if (fragment_data.contains("location") && fragment_data["location"].is_string()) {
+                item_ptr->set_location(fragment_data["location"].get<std::string>());
+            }
         }
     }
+}
 
-    if (items_data.contains("quest_items") && items_data["quest_items"].is_object()) {
-        const auto& quest_items = items_data["quest_items"];
-        if (quest_items.contains("crystal_fragments") && quest_items["crystal_fragments"].is_object()) {
-            for (const auto& [fragment_id, fragment_data] : quest_items["crystal_fragments"].items()) {
-                if (!fragment_data.is_object()) continue;
+std::shared_ptr<room> json_loader::build_room(const std::string& room_id, const json& room_data, const world& game_world) const {
+    auto room_ptr = game_world.create_room(symbol(room_id));
 
-                std::string item_id = "crystal_fragment_";
-                if (fragment_id.length() > 0) {
-                    item_id += fragment_id.back();
-                }
-                else {
-                    continue;
-                }
+    room_ptr->set_name(get_string(room_data, "name", room_id));
+    room_ptr->set_type(get_string(room_data, "type", "standard"));
+
+    if (room_data.contains("descriptions") && room_data["descriptions"].is_object()) {
+        const auto& descriptions = room_data["descriptions"];
+        room_ptr->set_short_description(get_string(descriptions, "short", "A nondescript area."));
+        room_ptr->set_long_description(get_string(descriptions, "long",
+            "You are in a nondescript area. There doesn't seem to be anything special here."));
+    }
+
+    if (room_data.contains("connections") && room_data["connections"].is_object()) {
+        for (const auto& [direction, connection] : room_data["connections"].items()) {
+            if (connection.is_string()) {
+                room_ptr->add_connection(direction, connection.get<std::string>());
+            }
+            else if (connection.is_object()) {
+                std::string target = get_string(connection, "leads_to");
+                std::string requires_ = get_string(connection, "requires");
 
-                auto item_ptr = game_world.get_item(item_id);
-                if (!item_ptr) {
-                    item_ptr = std::make_shared<item>(item_id);
-                    item_ptr->set_name("Crystal Fragment");
-                    item_ptr->set_description("A glowing fragment of the Echo Crystal.");
-                    item_ptr->set_type("quest_item");
-                    game_world.add_item(item_ptr);
+                if (!target.empty()) {
+                    room_ptr->add_connection(direction, target, requires_);
                 }
+            }
+        }
+    }
 
-                if (fragment_data.contains("location") && fragment_data["location"].is_string()) {
-                    item_ptr->set_location(fragment_data["location"].get<std::string>());
+    if (room_data.contains("features") && room_data["features"].is_array()) {
+        for (const auto& feature : room_data["features"]) {
+            if (feature.is_string()) {
+                room_ptr->add_feature(feature.get<std::string>());
+            }
+        }
+    }
+
+    if (room_data.contains("puzzles") && room_data["puzzles"].is_object()) {
+        for (const auto& [puzzle_id, puzzle_data] : room_data["puzzles"].items()) {
+            if (!puzzle_data.is_object()) continue;
+
+            puzzle new_puzzle;
+            new_puzzle.id = puzzle_id;
+            new_puzzle.type = get_string(puzzle_data, "type", "standard");
+            new_puzzle.command = puzzle_id; 
+            new_puzzle.object = "";
+
+            if (puzzle_data.contains("requires")) {
+                if (puzzle_data["requires"].is_array()) {
+                    for (const auto& req : puzzle_data["requires"]) {
+                        if (req.is_string()) {
+                            new_puzzle.required_items.push_back(req.get<std::string>());
+                        }
+                    }
                 }
+                else if (puzzle_data["requires"].is_string()) {
+                    new_puzzle.required_items.push_back(puzzle_data["requires"].get<std::string>());
+                }
+            }
+
+            new_puzzle.solution = get_string(puzzle_data, "solution");
+            new_puzzle.success_message = get_string(puzzle_data, "success_message", "You solved the puzzle!");
+            new_puzzle.failure_message = get_string(puzzle_data, "failure_message", "That didn't work.");
+            if (puzzle_data.contains("reward") && puzzle_data["reward"].is_string()) {
+                new_puzzle.reward_item = puzzle_data["reward"].get<std::string>();
             }
+
+            room_ptr->add_puzzle(new_puzzle);
         }
     }
+
+    return room_ptr;
 }
 
-void json_loader::load_rooms(const json& rooms_data, world& game_world) {
-    for (const auto& [room_id, room_data] : rooms_data.items()) {
-        if (!room_data.is_object()) continue;
+bool json_loader::load_scripts(const std::string& source, world& game_world) {
+    json j = json::parse(source, nullptr, false);
+    if (j.is_discarded() || !j.is_object()) {
+        std::cerr << "Failed to parse game scripts." << std::endl;
+        return false;
+    }
 
-        auto room_ptr = std::make_shared<room>(room_id);
+    load_script_rules(j, game_world);
+    return true;
+}
 
-        room_ptr->set_name(get_string(room_data, "name", room_id));
-        room_ptr->set_type(get_string(room_data, "type", "standard"));
+const std::string& json_loader::get_script_source() const {
+    return script_source;
+}
 
-        if (room_data.contains("descriptions") && room_data["descriptions"].is_object()) {
-            const auto& descriptions = room_data["descriptions"];
-            room_ptr->set_short_description(get_string(descriptions, "short", "A nondescript area."));
-            room_ptr->set_long_description(get_string(descriptions, "long",
-                "You are in a nondescript area. There doesn't seem to be anything special here."));
-        }
+void json_loader::load_script_rules(const json& scripts_data, world& game_world) {
+    auto engine = std::make_shared<script_engine>();
+
+    if (scripts_data.contains("rules") && scripts_data["rules"].is_array()) {
+        for (const auto& rule_data : scripts_data["rules"]) {
+            if (!rule_data.is_object() || !rule_data.contains("room")) {
+                continue;
+            }
+
+            script_rule rule;
+            rule.room = symbol(get_string(rule_data, "room"));
+            rule.always = get_string(rule_data, "trigger") == "always";
+
+            if (rule_data.contains("verbs")) {
+                rule.verbs = load_symbols(rule_data["verbs"]);
+            }
 
-        if (room_data.contains("connections") && room_data["connections"].is_object()) {
-            for (const auto& [direction, connection] : room_data["connections"].items()) {
-                if (connection.is_string()) {
-                    room_ptr->add_connection(direction, connection.get<std::string>());
+            if (rule_data.contains("objects") && rule_data["objects"].is_array()) {
+                for (const auto& object : rule_data["objects"]) {
+                    if (object.is_string()) {
+                        rule.objects.push_back(object.get<std::string>());
+                    }
                 }
-                else if (connection.is_object()) {
-                    std::string target = get_string(connection, "leads_to");
-                    std::string requires_ = get_string(connection, "requires");
+            }
 
-                    if (!target.empty()) {
-                        room_ptr->add_connection(direction, target, requires_);
+            if (rule_data.contains("object_contains") && rule_data["object_contains"].is_array()) {
+                for (const auto& object : rule_data["object_contains"]) {
+                    if (object.is_string()) {
+                        rule.object_contains.push_back(object.get<std::string>());
                     }
                 }
             }
+
+            if (rule_data.contains("when")) {
+                load_conditions(rule_data["when"], rule.conditions);
+            }
+
+            if (rule_data.contains("do")) {
+                load_effects(rule_data["do"], rule.effects);
+            }
+
+            engine->add_rule(std::move(rule));
         }
+    }
 
-        if (room_data.contains("features") && room_data["features"].is_array()) {
-            for (const auto& feature : room_data["features"]) {
-                if (feature.is_string()) {
-                    room_ptr->add_feature(feature.get<std::string>());
-                }
+    engine->add_builtin_natives();
+    engine->compile();
+
+    std::vector<symbol> flags;
+    engine->collect_flags(flags);
+    for (symbol flag : flags) {
+        game_world.declare_flag(flag);
+    }
+    game_world.set_scripts(engine);
+}
+
+std::vector<symbol> json_loader::load_symbols(const json& data) {
+    std::vector<symbol> symbols;
+    if (data.is_string()) {
+        symbols.push_back(symbol(data.get<std::string>()));
+    }
+    else if (data.is_array()) {
+        for (const auto& entry : data) {
+            if (entry.is_string()) {
+                symbols.push_back(symbol(entry.get<std::string>()));
             }
         }
+    }
+    return symbols;
+}
 
-        if (room_data.contains("puzzles") && room_data["puzzles"].is_object()) {
-            for (const auto& [puzzle_id, puzzle_data] : room_data["puzzles"].items()) {
-                if (!puzzle_data.is_object()) continue;
+void json_loader::load_conditions(const json& data, std::vector<script_condition>& conditions) {
+    if (!data.is_array()) {
+        return;
+    }
 
-                puzzle new_puzzle;
-                new_puzzle.id = puzzle_id;
-                new_puzzle.type = get_string(puzzle_data, "type", "standard");
-                new_puzzle.command = puzzle_id; 
-                new_puzzle.object = "";
+    for (const auto& condition_data : data) {
+        script_condition condition;
+        if (load_condition(condition_data, condition)) {
+            conditions.push_back(std::move(condition));
+        }
+    }
+}
 
-                if (puzzle_data.contains("requires")) {
-                    if (puzzle_data["requires"].is_array()) {
-                        for (const auto& req : puzzle_data["requires"]) {
-                            if (req.is_string()) {
-                                new_puzzle.required_items.push_back(req.get<std::string>());
-                            }
-                        }
-                    }
-                    else if (puzzle_data["requires"].is_string()) {
-                        new_puzzle.required_items.push_back(puzzle_data["requires"].get<std::string>());
-                    }
-                }
+bool json_loader::load_condition(const json& data, script_condition& condition) {
+    if (!data.is_object()) {
+        return false;
+    }
 
-                new_puzzle.solution = get_string(puzzle_data, "solution");
-                new_puzzle.success_message = get_string(puzzle_data, "success_message", "You solved the puzzle!");
-                new_puzzle.failure_message = get_string(puzzle_data, "failure_message", "That didn't work.");
-                if (puzzle_data.contains("reward") && puzzle_data["reward"].is_string()) {
-                    new_puzzle.reward_item = puzzle_data["reward"].get<std::string>();
-                }
+    if (data.contains("flag")) {
+        condition.type = script_condition_type::flag;
+        condition.subject = symbol(get_string(data, "flag"));
+    }
+    else if (data.contains("not_flag")) {
+        condition.type = script_condition_type::not_flag;
+        condition.subject = symbol(get_string(data, "not_flag"));
+    }
+    else if (data.contains("has_item")) {
+        condition.type = script_condition_type::has_item;
+        condition.subject = symbol(get_string(data, "has_item"));
+    }
+    else if (data.contains("item_missing")) {
+        condition.type = script_condition_type::item_missing;
+        condition.subject = symbol(get_string(data, "item_missing"));
+    }
+    else if (data.contains("npc_missing")) {
+        condition.type = script_condition_type::npc_missing;
+        condition.subject = symbol(get_string(data, "npc_missing"));
+    }
+    else if (data.contains("item_at")) {
+        condition.type = script_condition_type::item_at;
+        condition.subject = symbol(get_string(data, "item_at"));
+        if (data.contains("in")) {
+            condition.places = load_symbols(data["in"]);
+        }
+    }
+    else if (data.contains("item_not_at")) {
+        condition.type = script_condition_type::item_not_at;
+        condition.subject = symbol(get_string(data, "item_not_at"));
+        if (data.contains("in")) {
+            condition.places = load_symbols(data["in"]);
+        }
+    }
+    else if (data.contains("holds_at_least")) {
+        condition.type = script_condition_type::holds_at_least;
+        condition.count = get_int(data, "holds_at_least");
+        if (data.contains("items")) {
+            condition.items = load_symbols(data["items"]);
+        }
+    }
+    else if (data.contains("any")) {
+        condition.type = script_condition_type::any;
+        load_conditions(data["any"], condition.alternatives);
+    }
+    else {
+        std::cerr << "Unknown script condition: " << data.dump() << std::endl;
+        return false;
+    }
 
-                room_ptr->add_puzzle(new_puzzle);
-            }
+    return true;
+}
+
+void json_loader::load_effects(const json& data, std::vector<script_effect>& effects) {
+    if (!data.is_array()) {
+        return;
+    }
+
+    for (const auto& effect_data : data) {
+        script_effect effect;
+        if (load_effect(effect_data, effect)) {
+            effects.push_back(std::move(effect));
         }
+    }
+}
 
-        game_world.add_room(room_ptr);
+bool json_loader::load_effect(const json& data, script_effect& effect) {
+    if (!data.is_object()) {
+        return false;
     }
+
+    if (data.contains("say")) {
+        effect.type = script_effect_type::say;
+        effect.text = get_string(data, "say");
+    }
+    else if (data.contains("set_flag")) {
+        effect.type = script_effect_type::set_flag;
+        effect.subject = symbol(get_string(data, "set_flag"));
+    }
+    else if (data.contains("clear_flag")) {
+        effect.type = script_effect_type::clear_flag;
+        effect.subject = symbol(get_string(data, "clear_flag"));
+    }
+    else if (data.contains("move_item")) {
+        effect.type = script_effect_type::move_item;
+        effect.subject = symbol(get_string(data, "move_item"));
+        effect.place = symbol(get_string(data, "to"));
+    }
+    else if (data.contains("spawn_item")) {
+        effect.type = script_effect_type::spawn_item;
+        effect.subject = symbol(get_string(data, "spawn_item"));
+        effect.name = get_string(data, "name");
+        effect.description = get_string(data, "description");
+        effect.kind = get_string(data, "type");
+        effect.place = symbol(get_string(data, "location"));
+        if (data.contains("properties") && data["properties"].is_object()) {
+            for (const auto& [key, value] : data["properties"].items()) {
+                if (!value.is_object()) {
+                    effect.properties.emplace_back(symbol_table::intern(key), get_property_value(value));
+                }
+            }
+        }
+    }
+    else if (data.contains("give_item")) {
+        effect.type = script_effect_type::give_item;
+        effect.subject = symbol(get_string(data, "give_item"));
+        effect.text = get_string(data, "success");
+        effect.failure_text = get_string(data, "failure");
+    }
+    else if (data.contains("remove_items")) {
+        effect.type = script_effect_type::remove_items;
+        effect.targets = load_symbols(data["remove_items"]);
+    }
+    else if (data.contains("spawn_npc")) {
+        effect.type = script_effect_type::spawn_npc;
+        effect.subject = symbol(get_string(data, "spawn_npc"));
+        effect.name = get_string(data, "name");
+        effect.description = get_string(data, "description");
+        effect.kind = get_string(data, "role");
+        effect.place = symbol(get_string(data, "room"));
+    }
+    else if (data.contains("move_npc")) {
+        effect.type = script_effect_type::move_npc;
+        effect.subject = symbol(get_string(data, "move_npc"));
+        effect.place = symbol(get_string(data, "to"));
+    }
+    else if (data.contains("unlock")) {
+        effect.type = script_effect_type::unlock;
+        effect.subject = symbol(get_string(data, "unlock"));
+        if (data.contains("directions")) {
+            effect.targets = load_symbols(data["directions"]);
+        }
+    }
+    else if (data.contains("prompt")) {
+        effect.type = script_effect_type::prompt;
+        if (data["prompt"].is_object()) {
+            for (const auto& [answer, answer_effects] : data["prompt"].items()) {
+                std::vector<script_effect> effects;
+                load_effects(answer_effects, effects);
+                effect.answers.push_back({ answer, std::move(effects) });
+            }
+        }
+        if (data.contains("otherwise")) {
+            load_effects(data["otherwise"], effect.else_effects);
+        }
+    }
+    else if (data.contains("if")) {
+        effect.type = script_effect_type::branch;
+        load_conditions(data["if"], effect.conditions);
+        if (data.contains("then")) {
+            load_effects(data["then"], effect.then_effects);
+        }
+        if (data.contains("else")) {
+            load_effects(data["else"], effect.else_effects);
+        }
+    }
+    else {
+        std::cerr << "Unknown script effect: " << data.dump() << std::endl;
+        return false;
+    }
+
+    return true;
 }
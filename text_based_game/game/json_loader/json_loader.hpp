@@ -11,17 +11,33 @@ using json = nlohmann::json;
 class json_loader {
 public:
     bool load_game_data(const std::string& filename, world& game_world);
+    bool load_scripts(const std::string& source, world& game_world);
+    const std::string& get_script_source() const;
 
 private:
+    struct pending_entity;
+
+    std::string script_source;
+
     void load_game_config(const json& config, world& game_world);
     void load_world_state(const json& world_state, world& game_world);
     void load_player(const json& player_data, world& game_world);
-    void load_npcs(const json& npcs_data, world& game_world);
-    void load_items(const json& items_data, world& game_world);
-    void load_rooms(const json& rooms_data, world& game_world);
+    void load_quest_items(const json& quest_items, world& game_world);
+
+    void build_entities(std::vector<pending_entity>& batch, const world& game_world) const;
+    std::shared_ptr<npc> build_npc(const std::string& npc_id, const json& npc_data, const world& game_world) const;
+    std::shared_ptr<item> build_item(const std::string& item_id, const json& item_data, const world& game_world) const;
+    std::shared_ptr<room> build_room(const std::string& room_id, const json& room_data, const world& game_world) const;
+    void load_script_rules(const json& scripts_data, world& game_world);
+
+    std::vector<symbol> load_symbols(const json& data);
+    bool load_condition(const json& data, script_condition& condition);
+    bool load_effect(const json& data, script_effect& effect);
+    void load_conditions(const json& data, std::vector<script_condition>& conditions);
+    void load_effects(const json& data, std::vector<script_effect>& effects);
 
-    void setup_npc_behaviors(std::shared_ptr<npc>& npc_ptr, const json& npc_data, world& game_world);
-    void setup_dialogue(std::shared_ptr<npc>& npc_ptr, const std::string& state_name, const json& dialogue_data);
+    void setup_npc_behaviors(std::shared_ptr<npc>& npc_ptr, const json& npc_data) const;
+    void setup_dialogue(std::shared_ptr<npc>& npc_ptr, const std::string& state_name, const json& dialogue_data) const;
 };
 
 #endif 
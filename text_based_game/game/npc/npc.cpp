@@ -1,20 +1,47 @@
 #include "npc.hpp"
 #include "../world/world.hpp"
+#include "../snapshot/world_journal.hpp"
+#include "../world/npc_location_index.hpp"
 #include <iostream>
 #include <random>
 #include <chrono>
 
-npc::npc(const std::string& npc_id) : character(npc_id), state("initial") {}
+npc::npc(const std::string& npc_id) : npc(npc_id, std::make_shared<npc_content>()) {}
+
+npc::npc(const std::string& npc_id, std::shared_ptr<npc_content> initial_content) :
+    character(npc_id), content(std::move(initial_content)), state("initial"),
+    met_flag(symbol_table::intern("has_met_" + npc_id)), index(nullptr) {}
+
+npc_content& npc::edit_content() {
+    if (content.use_count() > 1) {
+        content = std::make_shared<npc_content>(*content);
+    }
+    return *content;
+}
+
+void npc::set_current_room(symbol room_id) {
+    if (index) {
+        index->relocate(this, current_room, room_id);
+    }
+    character::set_current_room(room_id);
+}
+
+void npc::set_location_index(npc_location_index* owner) {
+    index = owner;
+}
 
 void npc::set_role(const std::string& npc_role) {
-    role = npc_role;
+    edit_content().role = npc_role;
 }
 
 std::string npc::get_role() const {
-    return role;
+    return content->role;
 }
 
 void npc::set_state(const std::string& npc_state) {
+    if (journal && state != npc_state) {
+        journal->npc_state_changed(id, symbol_table::intern(npc_state));
+    }
     state = npc_state;
 }
 
@@ -22,20 +49,24 @@ std::string npc::get_state() const {
     return state;
 }
 
+symbol npc::get_met_flag() const {
+    return met_flag;
+}
+
 void npc::add_behavior(const std::string& state_name,
     std::function<void(world&, player&)> behavior) {
-    behavior_states[state_name] = behavior;
+    edit_content().behavior_states[state_name] = behavior;
 }
 
 void npc::add_dialogue_tree(const std::string& state_name, const std::string& tree_id,
     const dialogue_node& node) {
-    dialogue_trees[state_name][tree_id] = node;
+    edit_content().dialogue_trees[state_name][tree_id] = node;
 }
 
 const dialogue_node* npc::get_dialogue_node(const std::string& state_name,
     const std::string& node_id) const {
-    auto state_it = dialogue_trees.find(state_name);
-    if (state_it != dialogue_trees.end()) {
+    auto state_it = content->dialogue_trees.find(state_name);
+    if (state_it != content->dialogue_trees.end()) {
         auto node_it = state_it->second.find(node_id);
         if (node_it != state_it->second.end()) {
             return &node_it->second;
@@ -45,6 +76,18 @@ const dialogue_node* npc::get_dialogue_node(const std::string& state_name,
     return nullptr;
 }
 
+const std::unordered_map<std::string, std::unordered_map<std::string, dialogue_node>>& npc::get_dialogue_trees() const {
+    return content->dialogue_trees;
+}
+
+std::vector<std::string> npc::get_behavior_states() const {
+    std::vector<std::string> names;
+    for (const auto& pair : content->behavior_states) {
+        names.push_back(pair.first);
+    }
+    return names;
+}
+
 std::string npc::get_greeting() const {
     const auto* node = get_dialogue_node(state, "greeting");
     if (node) {
@@ -55,8 +98,8 @@ std::string npc::get_greeting() const {
 }
 
 void npc::update(world& game_world, player& player) {
-    auto behavior_it = behavior_states.find(state);
-    if (behavior_it != behavior_states.end()) {
+    auto behavior_it = content->behavior_states.find(state);
+    if (behavior_it != content->behavior_states.end()) {
         behavior_it->second(game_world, player);
     }
     else {
@@ -71,7 +114,7 @@ void npc::update(world& game_world, player& player) {
             if (room_ptr) {
                 const auto& connections = room_ptr->get_connections();
                 if (!connections.empty()) {
-                    std::vector<std::string> directions;
+                    std::vector<symbol> directions;
                     for (const auto& conn : connections) {
                         if (conn.second.requires_.empty()) { 
                             directions.push_back(conn.first);
@@ -80,16 +123,16 @@ void npc::update(world& game_world, player& player) {
 
                     if (!directions.empty()) {
                         std::uniform_int_distribution<int> dir_dist(0, directions.size() - 1);
-                        std::string direction = directions[dir_dist(generator)];
-                        std::string new_room = connections.at(direction).room_id;
+                        symbol direction = directions[dir_dist(generator)];
+                        symbol new_room = connections.at(direction).room_id;
 
-                        if (player.get_current_room() == current_room) {
+                        if (player.get_current_room_symbol() == current_room) {
                             std::cout << name << " leaves to the " << direction << "." << std::endl;
                         }
 
                         current_room = new_room;
 
-                        if (player.get_current_room() == current_room) {
+                        if (player.get_current_room_symbol() == current_room) {
                             std::cout << name << " enters." << std::endl;
                         }
                     }
@@ -100,8 +143,8 @@ void npc::update(world& game_world, player& player) {
 }
 
 std::string npc::talk(const std::string& option_index, world& game_world, player& player) {
-    std::string node_id = game_world.get_game_flag("has_met_" + id) ? "return_visit" : "first_interaction";
-    game_world.set_game_flag("has_met_" + id, true);
+    std::string node_id = game_world.get_game_flag(met_flag) ? "return_visit" : "first_interaction";
+    game_world.set_game_flag(met_flag, true);
 
     const auto* node = get_dialogue_node(state, node_id);
     if (!node) {
@@ -11,6 +11,7 @@
 
 class world;
 class player;
+class npc_location_index;
 
 struct dialogue_option {
     std::string text;
@@ -26,22 +27,36 @@ struct dialogue_node {
     std::vector<dialogue_option> options;
 };
 
-class npc : public character {
-private:
+struct npc_content {
     std::string role;
-    std::string state;
     std::unordered_map<std::string,
         std::function<void(world&, player&)>> behavior_states;
     std::unordered_map<std::string, std::unordered_map<std::string, dialogue_node>> dialogue_trees;
+};
+
+class npc : public character {
+private:
+    std::shared_ptr<npc_content> content;
+    std::string state;
+    symbol met_flag;
+    npc_location_index* index;
+
+    npc_content& edit_content();
 
 public:
     npc(const std::string& npc_id);
+    npc(const std::string& npc_id, std::shared_ptr<npc_content> initial_content);
+
+    using character::set_current_room;
+    void set_current_room(symbol room_id) override;
+    void set_location_index(npc_location_index* owner);
 
     void set_role(const std::string& npc_role);
     std::string get_role() const;
 
     void set_state(const std::string& npc_state);
     std::string get_state() const;
+    symbol get_met_flag() const;
 
     void add_behavior(const std::string& state_name,
         std::function<void(world&, player&)> behavior);
@@ -51,6 +66,8 @@ public:
 
     const dialogue_node* get_dialogue_node(const std::string& state_name,
         const std::string& node_id) const;
+    const std::unordered_map<std::string, std::unordered_map<std::string, dialogue_node>>& get_dialogue_trees() const;
+    std::vector<std::string> get_behavior_states() const;
 
     std::string get_greeting() const;
 
@@ -0,0 +1,656 @@
+#include "content_pack.hpp"
+#include "../json_loader/json_loader.hpp"
+#include "../snapshot/binary_format.hpp"
+#include <iostream>
+#include <cstring>
+#include <vector>
+#include <algorithm>
+#include <unordered_set>
+#include <filesystem>
+
+namespace {
+    const char pack_magic[8] = { 'L', 'O', 'E', 'P', 'A', 'C', 'K', '\0' };
+    const uint32_t byte_order_mark = 0x01020304;
+
+    struct pack_range {
+        uint32_t first;
+        uint32_t count;
+    };
+
+    struct pack_header {
+        char magic[8];
+        uint32_t version;
+        uint32_t byte_order;
+        uint32_t file_size;
+        uint32_t world_name;
+        uint32_t world_description;
+        uint32_t starting_room;
+        uint32_t day_cycle;
+        uint32_t weather;
+        uint32_t scripts;
+        int32_t player_health;
+        int32_t player_inventory_size;
+        pack_range starting_inventory;
+        binary_section strings;
+        binary_section string_data;
+        binary_section string_lists;
+        binary_section flags;
+        binary_section items;
+        binary_section properties;
+        binary_section rooms;
+        binary_section connections;
+        binary_section puzzles;
+        binary_section npcs;
+        binary_section dialogue_nodes;
+        binary_section dialogue_options;
+    };
+
+    struct flag_record {
+        uint32_t name;
+        uint32_t value;
+    };
+
+    struct item_record {
+        uint32_t id;
+        uint32_t name;
+        uint32_t description;
+        uint32_t type;
+        uint32_t location;
+        pack_range properties;
+    };
+
+    struct property_record {
+        uint32_t key;
+        uint32_t kind;
+        uint32_t value;
+    };
+
+    struct room_record {
+        uint32_t id;
+        uint32_t name;
+        uint32_t short_description;
+        uint32_t long_description;
+        uint32_t type;
+        pack_range connections;
+        pack_range features;
+        pack_range puzzles;
+    };
+
+    struct connection_record {
+        uint32_t direction;
+        uint32_t target;
+        uint32_t requirement;
+    };
+
+    struct puzzle_record {
+        uint32_t id;
+        uint32_t type;
+        uint32_t command;
+        uint32_t object;
+        pack_range required_items;
+        uint32_t solution;
+        uint32_t success_message;
+        uint32_t failure_message;
+        uint32_t reward_item;
+        uint32_t unlocks_path;
+        uint32_t sets_flag;
+    };
+
+    struct npc_record {
+        uint32_t id;
+        uint32_t name;
+        uint32_t description;
+        uint32_t role;
+        uint32_t room;
+        uint32_t state;
+        pack_range behaviors;
+        pack_range dialogue_nodes;
+    };
+
+    struct dialogue_node_record {
+        uint32_t state;
+        uint32_t tree;
+        uint32_t npc_text;
+        pack_range options;
+    };
+
+    struct dialogue_option_record {
+        uint32_t text;
+        uint32_t response;
+        uint32_t leads_to;
+        uint32_t updates_state;
+        uint32_t reveals_item;
+        uint32_t adds_journal_entry;
+    };
+
+    pack_range next_range(size_t first, size_t end) {
+        return { static_cast<uint32_t>(first), static_cast<uint32_t>(end - first) };
+    }
+
+    bool within(const pack_range& range, const binary_section& section) {
+        return range.first <= section.count && range.count <= section.count - range.first;
+    }
+
+    std::vector<std::string> range_strings(const uint32_t* lists, const pack_range& range, const string_table_view& strings) {
+        std::vector<std::string> values;
+        values.reserve(range.count);
+        for (uint32_t i = range.first; i < range.first + range.count; ++i) {
+            values.push_back(strings.str(lists[i]));
+        }
+        return values;
+    }
+
+    class pack_reader : public room_source {
+    public:
+        mapped_file file;
+        const pack_header* header;
+        const uint32_t* lists;
+        const flag_record* flags;
+        const item_record* items;
+        const property_record* properties;
+        const room_record* rooms;
+        const connection_record* connections;
+        const puzzle_record* puzzles;
+        const npc_record* npcs;
+        const dialogue_node_record* dialogue_nodes;
+        const dialogue_option_record* dialogue_options;
+        string_table_view strings;
+
+        bool open(const std::string& path);
+        bool validate() const;
+        size_t footprint(const room_record& record) const;
+        std::shared_ptr<room> build_room(const room_record& record, std::shared_ptr<room> room_ptr);
+        std::shared_ptr<room> load_room(symbol room_id, size_t& room_footprint) override;
+        void visit_connections(const std::function<void(symbol, symbol, const room_connection&)>& visit) override;
+    };
+
+    bool pack_reader::open(const std::string& path) {
+        if (!file.open(path) || file.size() < sizeof(pack_header)) {
+            return false;
+        }
+
+        header = reinterpret_cast<const pack_header*>(file.data());
+        if (std::memcmp(header->magic, pack_magic, sizeof(pack_magic)) != 0 ||
+            header->version != content_pack::version || header->byte_order != byte_order_mark ||
+            header->file_size != file.size()) {
+            std::cerr << "Unsupported content pack: " << path << std::endl;
+            return false;
+        }
+
+        lists = section_records<uint32_t>(file, header->string_lists);
+        flags = section_records<flag_record>(file, header->flags);
+        items = section_records<item_record>(file, header->items);
+        properties = section_records<property_record>(file, header->properties);
+        rooms = section_records<room_record>(file, header->rooms);
+        connections = section_records<connection_record>(file, header->connections);
+        puzzles = section_records<puzzle_record>(file, header->puzzles);
+        npcs = section_records<npc_record>(file, header->npcs);
+        dialogue_nodes = section_records<dialogue_node_record>(file, header->dialogue_nodes);
+        dialogue_options = section_records<dialogue_option_record>(file, header->dialogue_options);
+        if (!strings.open(file, header->strings, header->string_data) || !lists || !flags || !items ||
+            !properties || !rooms || !connections || !puzzles || !npcs || !dialogue_nodes ||
+            !dialogue_options || !validate()) {
+            std::cerr << "Corrupt content pack: " << path << std::endl;
+            return false;
+        }
+        return true;
+    }
+
+    bool pack_reader::validate() const {
+        auto has = [this](std::initializer_list<uint32_t> indices) {
+            for (uint32_t index : indices) {
+                if (!strings.contains(index)) {
+                    return false;
+                }
+            }
+            return true;
+        };
+
+        bool valid = has({ header->world_name, header->world_description, header->starting_room,
+            header->day_cycle, header->weather, header->scripts }) &&
+            within(header->starting_inventory, header->string_lists);
+        for (uint32_t i = 0; valid && i < header->string_lists.count; ++i) {
+            valid = strings.contains(lists[i]);
+        }
+        for (uint32_t i = 0; valid && i < header->flags.count; ++i) {
+            valid = strings.contains(flags[i].name);
+        }
+        for (uint32_t i = 0; valid && i < header->items.count; ++i) {
+            const auto& record = items[i];
+            valid = has({ record.id, record.name, record.description, record.type, record.location }) &&
+                within(record.properties, header->properties);
+        }
+        for (uint32_t i = 0; valid && i < header->properties.count; ++i) {
+            valid = has({ properties[i].key, properties[i].value }) &&
+                properties[i].kind <= static_cast<uint32_t>(property_kind::list);
+        }
+        for (uint32_t i = 0; valid && i < header->rooms.count; ++i) {
+            const auto& record = rooms[i];
+            valid = has({ record.id, record.name, record.short_description, record.long_description, record.type }) &&
+                within(record.connections, header->connections) && within(record.features, header->string_lists) &&
+                within(record.puzzles, header->puzzles);
+        }
+        for (uint32_t i = 0; valid && i < header->connections.count; ++i) {
+            const auto& record = connections[i];
+            valid = has({ record.direction, record.target, record.requirement });
+        }
+        for (uint32_t i = 0; valid && i < header->puzzles.count; ++i) {
+            const auto& record = puzzles[i];
+            valid = has({ record.id, record.type, record.command, record.object, record.solution,
+                record.success_message, record.failure_message, record.reward_item,
+                record.unlocks_path, record.sets_flag }) &&
+                within(record.required_items, header->string_lists);
+        }
+        for (uint32_t i = 0; valid && i < header->npcs.count; ++i) {
+            const auto& record = npcs[i];
+            valid = has({ record.id, record.name, record.description, record.role, record.room, record.state }) &&
+                within(record.behaviors, header->string_lists) && within(record.dialogue_nodes, header->dialogue_nodes);
+        }
+        for (uint32_t i = 0; valid && i < header->dialogue_nodes.count; ++i) {
+            const auto& record = dialogue_nodes[i];
+            valid = has({ record.state, record.tree, record.npc_text }) &&
+                within(record.options, header->dialogue_options);
+        }
+        for (uint32_t i = 0; valid && i < header->dialogue_options.count; ++i) {
+            const auto& record = dialogue_options[i];
+            valid = has({ record.text, record.response, record.leads_to, record.updates_state,
+                record.reveals_item, record.adds_journal_entry });
+        }
+        for (uint32_t i = 1; valid && i < header->rooms.count; ++i) {
+            valid = strings.text(rooms[i - 1].id) < strings.text(rooms[i].id);
+        }
+        return valid;
+    }
+
+    std::shared_ptr<room> pack_reader::build_room(const room_record& record, std::shared_ptr<room> room_ptr) {
+        room_ptr->set_name(strings.str(record.name));
+        room_ptr->set_short_description(strings.str(record.short_description));
+        room_ptr->set_long_description(strings.str(record.long_description));
+        room_ptr->set_type(strings.str(record.type));
+
+        for (uint32_t c = record.connections.first; c < record.connections.first + record.connections.count; ++c) {
+            room_ptr->add_connection(strings.name(connections[c].direction),
+                strings.name(connections[c].target), strings.name(connections[c].requirement));
+        }
+
+        for (const auto& feature : range_strings(lists, record.features, strings)) {
+            room_ptr->add_feature(feature);
+        }
+
+        for (uint32_t p = record.puzzles.first; p < record.puzzles.first + record.puzzles.count; ++p) {
+            const auto& entry = puzzles[p];
+            puzzle room_puzzle;
+            room_puzzle.id = strings.str(entry.id);
+            room_puzzle.type = strings.str(entry.type);
+            room_puzzle.command = strings.str(entry.command);
+            room_puzzle.object = strings.str(entry.object);
+            room_puzzle.required_items = range_strings(lists, entry.required_items, strings);
+            room_puzzle.solution = strings.str(entry.solution);
+            room_puzzle.success_message = strings.str(entry.success_message);
+            room_puzzle.failure_message = strings.str(entry.failure_message);
+            room_puzzle.reward_item = strings.str(entry.reward_item);
+            room_puzzle.unlocks_path = strings.str(entry.unlocks_path);
+            room_puzzle.sets_flag = strings.str(entry.sets_flag);
+            room_ptr->add_puzzle(room_puzzle);
+        }
+
+        return room_ptr;
+    }
+
+    size_t pack_reader::footprint(const room_record& record) const {
+        size_t bytes = sizeof(room) + sizeof(room_content) +
+            strings.text(record.name).size() + strings.text(record.short_description).size() +
+            strings.text(record.long_description).size() + strings.text(record.type).size() +
+            record.connections.count * (sizeof(symbol) + sizeof(room_connection) + 2 * sizeof(void*)) +
+            record.features.count * sizeof(std::string) + record.puzzles.count * sizeof(puzzle);
+        for (uint32_t i = record.features.first; i < record.features.first + record.features.count; ++i) {
+            bytes += strings.text(lists[i]).size();
+        }
+        for (uint32_t p = record.puzzles.first; p < record.puzzles.first + record.puzzles.count; ++p) {
+            bytes += strings.text(puzzles[p].success_message).size() + strings.text(puzzles[p].failure_message).size();
+        }
+        return bytes;
+    }
+
+    std::shared_ptr<room> pack_reader::load_room(symbol room_id, size_t& room_footprint) {
+        const room_record* first = rooms;
+        const room_record* last = rooms + header->rooms.count;
+        const std::string& id = room_id.str();
+        const room_record* found = std::lower_bound(first, last, id,
+            [this](const room_record& record, const std::string& key) {
+                return strings.text(record.id) < key;
+            });
+        if (found == last || strings.text(found->id) != id) {
+            return nullptr;
+        }
+
+        // Faulted rooms are evictable, so they stay on the general heap rather
+        // than in the world's monotonic content arena.
+        room_footprint = footprint(*found);
+        return build_room(*found, std::make_shared<room>(strings.name(found->id)));
+    }
+
+    void pack_reader::visit_connections(const std::function<void(symbol, symbol, const room_connection&)>& visit) {
+        for (uint32_t r = 0; r < header->rooms.count; ++r) {
+            const room_record& record = rooms[r];
+            symbol room_id = strings.name(record.id);
+            for (uint32_t c = record.connections.first; c < record.connections.first + record.connections.count; ++c) {
+                visit(room_id, strings.name(connections[c].direction),
+                    room_connection(strings.name(connections[c].target), strings.name(connections[c].requirement)));
+            }
+        }
+    }
+}
+
+std::string content_pack::pack_path_for(const std::string& config_path) {
+    std::filesystem::path path(config_path);
+    path.replace_extension(".pack");
+    return path.string();
+}
+
+bool content_pack::is_current(const std::string& pack_path, const std::string& config_path) {
+    std::error_code error;
+    auto pack_time = std::filesystem::last_write_time(pack_path, error);
+    if (error) {
+        return false;
+    }
+
+    auto config_time = std::filesystem::last_write_time(config_path, error);
+    return error || pack_time >= config_time;
+}
+
+bool content_pack::compile(const std::string& config_path, const std::string& pack_path) {
+    world game_world;
+    json_loader loader;
+    if (!loader.load_game_data(config_path, game_world)) {
+        return false;
+    }
+
+    if (!save(pack_path, game_world, loader.get_script_source())) {
+        std::cerr << "Failed to write content pack: " << pack_path << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool content_pack::save(const std::string& path, const world& game_world, const std::string& script_source) {
+    string_pool pool;
+
+    pack_header header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, pack_magic, sizeof(pack_magic));
+    header.version = version;
+    header.byte_order = byte_order_mark;
+    header.world_name = pool.add(game_world.get_world_name());
+    header.world_description = pool.add(game_world.get_world_description());
+    header.starting_room = pool.add(game_world.get_starting_room());
+    header.day_cycle = pool.add(game_world.get_day_cycle());
+    header.weather = pool.add(game_world.get_weather());
+    header.scripts = pool.add(script_source);
+    header.player_health = game_world.get_player_health();
+    header.player_inventory_size = game_world.get_player_inventory_size();
+
+    std::vector<uint32_t> lists;
+    for (symbol item_id : game_world.get_starting_inventory()) {
+        lists.push_back(pool.add(item_id));
+    }
+    header.starting_inventory = next_range(0, lists.size());
+
+    std::vector<flag_record> flags;
+    for (const auto& pair : game_world.get_game_flags()) {
+        flags.push_back({ pool.add(pair.first), pair.second ? 1u : 0u });
+    }
+
+    // Items are written bucket by bucket so each location lists its items in
+    // the same order as the world the pack was compiled from.
+    std::vector<symbol> locations;
+    std::unordered_set<symbol> seen_locations;
+    for (const auto& item_entry : game_world.get_items()) {
+        symbol location = item_entry.get_location_symbol();
+        if (seen_locations.insert(location).second) {
+            locations.push_back(location);
+        }
+    }
+
+    std::vector<item_record> items;
+    std::vector<property_record> properties;
+    for (symbol location : locations) {
+        for (const item* item_ptr : game_world.get_items_in_room(location)) {
+            item_record record;
+            record.id = pool.add(item_ptr->get_id_symbol());
+            record.name = pool.add(item_ptr->get_name());
+            record.description = pool.add(item_ptr->get_description());
+            record.type = pool.add(item_ptr->get_type());
+            record.location = pool.add(location);
+            size_t first_property = properties.size();
+            for (const auto& property : item_ptr->get_properties()) {
+                properties.push_back({ pool.add(property.first),
+                    static_cast<uint32_t>(property.second.kind()), pool.add(property.second.to_string()) });
+            }
+            record.properties = next_range(first_property, properties.size());
+            items.push_back(record);
+        }
+    }
+
+    std::vector<room_record> rooms;
+    std::vector<connection_record> connections;
+    std::vector<puzzle_record> puzzles;
+    // Rooms are sorted by id so lazy loading can find them by binary search.
+    std::vector<const room*> sorted_rooms;
+    for (const auto& room_entry : game_world.get_rooms()) {
+        sorted_rooms.push_back(&room_entry);
+    }
+    std::sort(sorted_rooms.begin(), sorted_rooms.end(), [](const room* left, const room* right) {
+        return left->get_id() < right->get_id();
+    });
+
+    for (const room* room_ptr : sorted_rooms) {
+        const room& current = *room_ptr;
+        room_record record;
+        record.id = pool.add(current.get_id_symbol());
+        record.name = pool.add(current.get_name());
+        record.short_description = pool.add(current.get_short_description());
+        record.long_description = pool.add(current.get_long_description());
+        record.type = pool.add(current.get_type());
+
+        // Connections go out in the sorted order the JSON loader inserts them,
+        // so the rebuilt exit maps list directions identically.
+        std::vector<std::pair<symbol, room_connection>> exits(current.get_connections().begin(),
+            current.get_connections().end());
+        std::sort(exits.begin(), exits.end(), [](const auto& left, const auto& right) {
+            return left.first.str() < right.first.str();
+        });
+
+        size_t first_connection = connections.size();
+        for (const auto& connection : exits) {
+            connections.push_back({ pool.add(connection.first),
+                pool.add(connection.second.room_id), pool.add(connection.second.requires_) });
+        }
+        record.connections = next_range(first_connection, connections.size());
+
+        size_t first_feature = lists.size();
+        pool.add_list(current.get_features(), lists);
+        record.features = next_range(first_feature, lists.size());
+
+        size_t first_puzzle = puzzles.size();
+        for (const auto& room_puzzle : current.get_puzzles()) {
+            puzzle_record entry;
+            entry.id = pool.add(room_puzzle.id);
+            entry.type = pool.add(room_puzzle.type);
+            entry.command = pool.add(room_puzzle.command);
+            entry.object = pool.add(room_puzzle.object);
+            size_t first_required = lists.size();
+            pool.add_list(room_puzzle.required_items, lists);
+            entry.required_items = next_range(first_required, lists.size());
+            entry.solution = pool.add(room_puzzle.solution);
+            entry.success_message = pool.add(room_puzzle.success_message);
+            entry.failure_message = pool.add(room_puzzle.failure_message);
+            entry.reward_item = pool.add(room_puzzle.reward_item);
+            entry.unlocks_path = pool.add(room_puzzle.unlocks_path);
+            entry.sets_flag = pool.add(room_puzzle.sets_flag);
+            puzzles.push_back(entry);
+        }
+        record.puzzles = next_range(first_puzzle, puzzles.size());
+        rooms.push_back(record);
+    }
+
+    std::vector<npc_record> npcs;
+    std::vector<dialogue_node_record> dialogue_nodes;
+    std::vector<dialogue_option_record> dialogue_options;
+    for (const auto& npc_entry : game_world.get_npcs()) {
+        npc_record record;
+        record.id = pool.add(npc_entry.get_id_symbol());
+        record.name = pool.add(npc_entry.get_name());
+        record.description = pool.add(npc_entry.get_description());
+        record.role = pool.add(npc_entry.get_role());
+        record.room = pool.add(npc_entry.get_current_room_symbol());
+        record.state = pool.add(npc_entry.get_state());
+
+        size_t first_behavior = lists.size();
+        pool.add_list(npc_entry.get_behavior_states(), lists);
+        record.behaviors = next_range(first_behavior, lists.size());
+
+        size_t first_node = dialogue_nodes.size();
+        for (const auto& state_trees : npc_entry.get_dialogue_trees()) {
+            for (const auto& tree : state_trees.second) {
+                dialogue_node_record node;
+                node.state = pool.add(state_trees.first);
+                node.tree = pool.add(tree.first);
+                node.npc_text = pool.add(tree.second.npc_text);
+                size_t first_option = dialogue_options.size();
+                for (const auto& option : tree.second.options) {
+                    dialogue_options.push_back({ pool.add(option.text), pool.add(option.response),
+                        pool.add(option.leads_to), pool.add(option.updates_state),
+                        pool.add(option.reveals_item), pool.add(option.adds_journal_entry) });
+                }
+                node.options = next_range(first_option, dialogue_options.size());
+                dialogue_nodes.push_back(node);
+            }
+        }
+        record.dialogue_nodes = next_range(first_node, dialogue_nodes.size());
+        npcs.push_back(record);
+    }
+
+    std::vector<char> buffer(sizeof(header));
+    header.string_lists = append_records(buffer, lists);
+    header.flags = append_records(buffer, flags);
+    header.items = append_records(buffer, items);
+    header.properties = append_records(buffer, properties);
+    header.rooms = append_records(buffer, rooms);
+    header.connections = append_records(buffer, connections);
+    header.puzzles = append_records(buffer, puzzles);
+    header.npcs = append_records(buffer, npcs);
+    header.dialogue_nodes = append_records(buffer, dialogue_nodes);
+    header.dialogue_options = append_records(buffer, dialogue_options);
+    pool.append_to(buffer, header.strings, header.string_data);
+    header.file_size = static_cast<uint32_t>(buffer.size());
+    std::memcpy(buffer.data(), &header, sizeof(header));
+
+    return write_binary_file(path, buffer);
+}
+
+bool content_pack::load(const std::string& path, world& game_world, size_t room_budget) {
+    auto reader = std::make_shared<pack_reader>();
+    if (!reader->open(path)) {
+        return false;
+    }
+
+    const auto& header = *reader->header;
+    const auto* lists = reader->lists;
+    const auto* flags = reader->flags;
+    const auto* items = reader->items;
+    const auto* properties = reader->properties;
+    const auto* npcs = reader->npcs;
+    const auto* dialogue_nodes = reader->dialogue_nodes;
+    const auto* dialogue_options = reader->dialogue_options;
+    auto& strings = reader->strings;
+
+    game_world.set_world_name(strings.str(header.world_name));
+    game_world.set_world_description(strings.str(header.world_description));
+    game_world.set_starting_room(strings.str(header.starting_room));
+    game_world.set_day_cycle(strings.str(header.day_cycle));
+    game_world.set_weather(strings.str(header.weather));
+    game_world.set_player_health(header.player_health);
+    game_world.set_player_inventory_size(header.player_inventory_size);
+    for (const auto& item_id : range_strings(lists, header.starting_inventory, strings)) {
+        game_world.add_starting_item(item_id);
+    }
+
+    for (uint32_t i = 0; i < header.flags.count; ++i) {
+        game_world.declare_flag(strings.name(flags[i].name));
+        game_world.set_game_flag(strings.name(flags[i].name), flags[i].value != 0);
+    }
+
+    for (uint32_t i = 0; i < header.items.count; ++i) {
+        const auto& record = items[i];
+        auto item_ptr = game_world.create_item(strings.name(record.id));
+        item_ptr->set_name(strings.str(record.name));
+        item_ptr->set_description(strings.str(record.description));
+        item_ptr->set_type(strings.str(record.type));
+        item_ptr->set_location(strings.name(record.location));
+        for (uint32_t p = record.properties.first; p < record.properties.first + record.properties.count; ++p) {
+            item_ptr->set_property(strings.name(properties[p].key), property_value::parse(
+                static_cast<property_kind>(properties[p].kind), strings.text(properties[p].value)));
+        }
+        game_world.add_item(item_ptr);
+    }
+
+    // Worlds whose rooms would not fit the budget fault them in on demand
+    // from the mapped pack instead of building them all up front.
+    size_t room_bytes = 0;
+    for (uint32_t i = 0; i < header.rooms.count; ++i) {
+        room_bytes += reader->footprint(reader->rooms[i]);
+    }
+
+    if (room_budget != 0 && room_bytes > room_budget) {
+        game_world.set_room_source(reader, room_budget);
+    }
+    else {
+        for (uint32_t i = 0; i < header.rooms.count; ++i) {
+            const auto& record = reader->rooms[i];
+            game_world.add_room(reader->build_room(record, game_world.create_room(strings.name(record.id))));
+        }
+    }
+
+    for (uint32_t i = 0; i < header.npcs.count; ++i) {
+        const auto& record = npcs[i];
+        auto npc_ptr = game_world.create_npc(strings.str(record.id));
+        npc_ptr->set_name(strings.str(record.name));
+        npc_ptr->set_description(strings.str(record.description));
+        npc_ptr->set_role(strings.str(record.role));
+        npc_ptr->set_current_room(strings.name(record.room));
+
+        for (const auto& state_name : range_strings(lists, record.behaviors, strings)) {
+            npc_ptr->add_behavior(state_name, [](world&, player&) {
+            });
+        }
+
+        for (uint32_t n = record.dialogue_nodes.first; n < record.dialogue_nodes.first + record.dialogue_nodes.count; ++n) {
+            const auto& entry = dialogue_nodes[n];
+            dialogue_node node;
+            node.npc_text = strings.str(entry.npc_text);
+            for (uint32_t o = entry.options.first; o < entry.options.first + entry.options.count; ++o) {
+                const auto& option_record = dialogue_options[o];
+                dialogue_option option;
+                option.text = strings.str(option_record.text);
+                option.response = strings.str(option_record.response);
+                option.leads_to = strings.str(option_record.leads_to);
+                option.updates_state = strings.str(option_record.updates_state);
+                option.reveals_item = strings.str(option_record.reveals_item);
+                option.adds_journal_entry = strings.str(option_record.adds_journal_entry);
+                node.options.push_back(option);
+            }
+            npc_ptr->add_dialogue_tree(strings.str(entry.state), strings.str(entry.tree), node);
+        }
+
+        npc_ptr->set_state(strings.str(record.state));
+        game_world.add_npc(npc_ptr);
+    }
+
+    if (strings.text(header.scripts).empty()) {
+        return true;
+    }
+
+    json_loader loader;
+    return loader.load_scripts(strings.str(header.scripts), game_world);
+}
@@ -0,0 +1,21 @@
+#ifndef CONTENT_PACK_HPP
+#define CONTENT_PACK_HPP
+
+#include "../world/world.hpp"
+#include "../includes.hpp"
+#include <string>
+#include <cstdint>
+
+class content_pack {
+public:
+    static const uint32_t version = 3;
+
+    static std::string pack_path_for(const std::string& config_path);
+    static bool is_current(const std::string& pack_path, const std::string& config_path);
+
+    static bool compile(const std::string& config_path, const std::string& pack_path);
+    static bool save(const std::string& path, const world& game_world, const std::string& script_source);
+    static bool load(const std::string& path, world& game_world, size_t room_budget = 0);
+};
+
+#endif
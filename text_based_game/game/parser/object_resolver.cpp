@@ -0,0 +1,144 @@
+#include "object_resolver.hpp"
+#include <algorithm>
+
+namespace {
+    bool rank_match(const std::string& text, std::string_view obj, match_rank& rank) {
+        size_t pos = text.find(obj);
+        if (pos == std::string::npos) {
+            return false;
+        }
+
+        if (pos != 0) {
+            rank = match_rank::substring;
+        }
+        else if (text.size() == obj.size()) {
+            rank = match_rank::exact;
+        }
+        else {
+            rank = match_rank::prefix;
+        }
+        return true;
+    }
+
+    template <typename Entity>
+    bool rank_entity(const Entity& entity, std::string_view obj, match_rank& rank) {
+        match_rank name_rank = match_rank::substring;
+        match_rank id_rank = match_rank::substring;
+        bool name_match = rank_match(entity.get_match_name(), obj, name_rank);
+        bool id_match = rank_match(entity.get_match_id(), obj, id_rank);
+        if (!name_match && !id_match) {
+            return false;
+        }
+
+        if (!name_match) {
+            rank = id_rank;
+        }
+        else if (!id_match) {
+            rank = name_rank;
+        }
+        else {
+            rank = std::max(name_rank, id_rank);
+        }
+        return true;
+    }
+
+    bool is_pronoun(std::string_view obj) {
+        return obj == "it";
+    }
+}
+
+void object_resolver::consider(item* item_ptr, npc* npc_ptr, resolve_scope scope, std::string_view obj) {
+    match_rank rank = match_rank::substring;
+    bool matched = item_ptr ? rank_entity(*item_ptr, obj, rank) : rank_entity(*npc_ptr, obj, rank);
+    if (matched) {
+        candidates.push_back({ item_ptr, npc_ptr, scope, rank });
+    }
+}
+
+void object_resolver::resolve_pronoun(unsigned scopes, const player& player, const world& world) {
+    if (item* item_ptr = world.get_item(last_item)) {
+        const auto& inventory = player.get_inventory();
+        if ((scopes & scope_inventory) && std::find(inventory.begin(), inventory.end(), item_ptr) != inventory.end()) {
+            candidates.push_back({ item_ptr, nullptr, scope_inventory, match_rank::exact });
+        }
+        else if ((scopes & scope_room) && item_ptr->get_location_symbol() == player.get_current_room_symbol()) {
+            candidates.push_back({ item_ptr, nullptr, scope_room, match_rank::exact });
+        }
+        return;
+    }
+
+    npc* npc_ptr = world.get_npc(last_npc);
+    if (npc_ptr && (scopes & scope_npcs) && npc_ptr->get_current_room_symbol() == player.get_current_room_symbol()) {
+        candidates.push_back({ nullptr, npc_ptr, scope_npcs, match_rank::exact });
+    }
+}
+
+const std::vector<resolved_object>& object_resolver::resolve(std::string_view obj, unsigned scopes,
+    const player& player, const world& world) {
+    candidates.clear();
+    if (obj.empty()) {
+        return candidates;
+    }
+
+    if (is_pronoun(obj)) {
+        resolve_pronoun(scopes, player, world);
+        return candidates;
+    }
+
+    if (scopes & scope_inventory) {
+        for (item* item_ptr : player.get_inventory()) {
+            consider(item_ptr, nullptr, scope_inventory, obj);
+        }
+    }
+
+    symbol room = player.get_current_room_symbol();
+    if (scopes & scope_room) {
+        for (item* item_ptr : world.get_items_in_room(room)) {
+            consider(item_ptr, nullptr, scope_room, obj);
+        }
+    }
+
+    if (scopes & scope_npcs) {
+        for (npc* npc_ptr : world.get_npcs_in_room(room)) {
+            consider(nullptr, npc_ptr, scope_npcs, obj);
+        }
+    }
+
+    std::stable_sort(candidates.begin(), candidates.end(),
+        [](const resolved_object& a, const resolved_object& b) {
+            return a.rank > b.rank;
+        });
+    return candidates;
+}
+
+const resolved_object* object_resolver::resolve_best(std::string_view obj, unsigned scopes,
+    const player& player, const world& world) {
+    const auto& ranked = resolve(obj, scopes, player, world);
+    if (ranked.empty()) {
+        return nullptr;
+    }
+
+    remember(ranked.front(), world);
+    return &ranked.front();
+}
+
+item* object_resolver::resolve_item(std::string_view obj, unsigned scopes, const player& player, const world& world) {
+    const resolved_object* best = resolve_best(obj, scopes & scope_items, player, world);
+    return best ? best->item_ptr : nullptr;
+}
+
+void object_resolver::remember(const resolved_object& target, const world& world) {
+    last_item = {};
+    last_npc = {};
+    if (target.item_ptr) {
+        last_item = world.find_item(target.item_ptr->get_id_symbol());
+    }
+    else if (target.npc_ptr) {
+        last_npc = world.find_npc(target.npc_ptr->get_id_symbol());
+    }
+}
+
+void object_resolver::forget() {
+    last_item = {};
+    last_npc = {};
+}
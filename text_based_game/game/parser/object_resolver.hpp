@@ -0,0 +1,57 @@
+#ifndef OBJECT_RESOLVER_HPP
+#define OBJECT_RESOLVER_HPP
+
+#include "../player/player.hpp"
+#include "../world/world.hpp"
+#include "../includes.hpp"
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstdint>
+
+enum class match_rank : std::uint8_t {
+    substring,
+    prefix,
+    exact
+};
+
+enum resolve_scope : unsigned {
+    scope_inventory = 1u << 0,
+    scope_room = 1u << 1,
+    scope_npcs = 1u << 2,
+    scope_items = scope_inventory | scope_room,
+    scope_all = scope_items | scope_npcs
+};
+
+struct resolved_object {
+    item* item_ptr = nullptr;
+    npc* npc_ptr = nullptr;
+    resolve_scope scope = scope_inventory;
+    match_rank rank = match_rank::substring;
+};
+
+// Resolves a normalized object phrase against what the player can refer to.
+// Candidates come back best first: exact beats prefix beats substring, and
+// within a rank the inventory beats the room, which beats NPCs. The best
+// match is remembered by handle so "it" can refer back to it later.
+class object_resolver {
+private:
+    std::vector<resolved_object> candidates;
+    item_handle last_item;
+    npc_handle last_npc;
+
+    void consider(item* item_ptr, npc* npc_ptr, resolve_scope scope, std::string_view obj);
+    void resolve_pronoun(unsigned scopes, const player& player, const world& world);
+
+public:
+    const std::vector<resolved_object>& resolve(std::string_view obj, unsigned scopes,
+        const player& player, const world& world);
+    const resolved_object* resolve_best(std::string_view obj, unsigned scopes,
+        const player& player, const world& world);
+    item* resolve_item(std::string_view obj, unsigned scopes, const player& player, const world& world);
+
+    void remember(const resolved_object& target, const world& world);
+    void forget();
+};
+
+#endif
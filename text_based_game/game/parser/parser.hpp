@@ -3,21 +3,37 @@
 
 #include "../player/player.hpp"
 #include "../world/world.hpp"
+#include "object_resolver.hpp"
 #include <string>
+#include <string_view>
 #include <vector>
 #include <unordered_map>
-#include <functional>
 #include "../includes.hpp"
 
+struct parsed_command {
+    std::string_view verb;
+    std::string_view object;
+};
+
+using verb_handler = bool (*)(std::string_view object, player& player, world& world, object_resolver& resolver);
+
+// Built-in verbs live in a compile-time table; content_verbs holds verbs
+// registered at runtime and is only consulted when the built-in lookup misses.
 class parser {
 private:
-    std::unordered_map<std::string, std::function<bool(const std::string&, player&, world&)>> verb_handlers;
+    std::unordered_map<symbol, verb_handler> content_verbs;
+    object_resolver resolver;
 
 public:
-    parser();
+    bool register_verb(const std::string& verb, verb_handler handler);
+
+    static void normalize(std::string& buffer);
+    void parse_command(std::string_view input, parsed_command& command) const;
+    // Expects verb and object already passed through normalize().
+    bool execute_command(std::string_view verb, std::string_view object, player& player, world& world);
 
-    void parse_command(const std::string& input, std::string& verb, std::string& object) const;
-    bool execute_command(const std::string& verb, const std::string& object, player& player, world& world) const;
+    // Drops the remembered "it" target, for when the world is replaced.
+    void forget_references();
 };
 
 #endif 
@@ -0,0 +1,71 @@
+#ifndef VERB_TABLE_HPP
+#define VERB_TABLE_HPP
+
+#include <array>
+#include <cstdint>
+#include <cstddef>
+#include <string_view>
+
+// Fixed set of verbs resolved through a perfect hash. The constructor
+// searches for a seed under which every verb lands in its own bucket, so a
+// lookup is one hash, one bucket read and one string compare. Construct it
+// constexpr: a verb set with no collision-free seed fails to compile.
+template <typename Handler, std::size_t Count, std::size_t Buckets>
+class verb_table {
+    static_assert(Count < Buckets, "verb_table needs more buckets than verbs");
+    static_assert((Buckets & (Buckets - 1)) == 0, "verb_table bucket count must be a power of two");
+
+public:
+    struct entry {
+        std::string_view verb;
+        Handler handler;
+    };
+
+private:
+    static constexpr std::uint32_t max_seed = 1u << 16;
+
+    std::array<entry, Count> entries;
+    std::array<std::uint8_t, Buckets> buckets{};
+    std::uint32_t seed = 0;
+
+    static constexpr std::size_t bucket_of(std::uint32_t seed, std::string_view verb) {
+        std::uint32_t hash = 2166136261u ^ seed;
+        for (char c : verb) {
+            hash ^= static_cast<unsigned char>(c);
+            hash *= 16777619u;
+        }
+        // The low bits of an FNV hash only see the low bits of each byte.
+        return (hash >> 16) & (Buckets - 1);
+    }
+
+    constexpr bool try_seed(std::uint32_t candidate) {
+        buckets = {};
+        for (std::size_t i = 0; i < Count; ++i) {
+            std::size_t bucket = bucket_of(candidate, entries[i].verb);
+            if (buckets[bucket] != 0) {
+                return false;
+            }
+            buckets[bucket] = static_cast<std::uint8_t>(i + 1);
+        }
+        return true;
+    }
+
+public:
+    constexpr verb_table(const std::array<entry, Count>& verbs) : entries(verbs) {
+        while (!try_seed(seed)) {
+            if (++seed == max_seed) {
+                throw "verb_table: no collision-free seed";
+            }
+        }
+    }
+
+    constexpr Handler find(std::string_view verb) const {
+        std::uint8_t slot = buckets[bucket_of(seed, verb)];
+        if (slot == 0 || entries[slot - 1].verb != verb) {
+            return nullptr;
+        }
+        return entries[slot - 1].handler;
+    }
+};
+
+#endif
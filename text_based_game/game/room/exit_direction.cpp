@@ -0,0 +1,35 @@
+#include "exit_direction.hpp"
+
+static const symbol direction_symbols[exit_direction_count] = {
+    symbol_table::intern("north"),
+    symbol_table::intern("south"),
+    symbol_table::intern("east"),
+    symbol_table::intern("west"),
+    symbol_table::intern("up"),
+    symbol_table::intern("down")
+};
+
+bool parse_exit_direction(std::string_view word, exit_direction& result) {
+    if (word == "n" || word == "north") result = exit_direction::north;
+    else if (word == "s" || word == "south") result = exit_direction::south;
+    else if (word == "e" || word == "east") result = exit_direction::east;
+    else if (word == "w" || word == "west") result = exit_direction::west;
+    else if (word == "up") result = exit_direction::up;
+    else if (word == "down") result = exit_direction::down;
+    else return false;
+    return true;
+}
+
+bool exit_direction_of(symbol direction, exit_direction& result) {
+    for (size_t i = 0; i < exit_direction_count; ++i) {
+        if (direction_symbols[i] == direction) {
+            result = static_cast<exit_direction>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+symbol exit_direction_symbol(exit_direction direction) {
+    return direction_symbols[static_cast<size_t>(direction)];
+}
@@ -0,0 +1,25 @@
+#ifndef EXIT_DIRECTION_HPP
+#define EXIT_DIRECTION_HPP
+
+#include "../symbol/symbol_table.hpp"
+#include "../includes.hpp"
+#include <string_view>
+#include <cstdint>
+#include <cstddef>
+
+enum class exit_direction : uint8_t {
+    north,
+    south,
+    east,
+    west,
+    up,
+    down
+};
+
+const size_t exit_direction_count = 6;
+
+bool parse_exit_direction(std::string_view word, exit_direction& result);
+bool exit_direction_of(symbol direction, exit_direction& result);
+symbol exit_direction_symbol(exit_direction direction);
+
+#endif
@@ -1,88 +1,259 @@
 #include "room.hpp"
+#include "../snapshot/world_journal.hpp"
+#include "../world/nav_graph.hpp"
+#include <algorithm>
 
-room::room(const std::string& room_id) : id(room_id), has_visited(false) {}
+room::room(const std::string& room_id) : room(symbol_table::intern(room_id)) {}
+
+room::room(symbol room_id) : room(room_id, std::make_shared<room_content>()) {}
+
+room::room(symbol room_id, std::shared_ptr<room_content> initial_content) :
+    id(room_id), content(std::move(initial_content)), has_visited(false), modified(false), journal(nullptr), navigation(nullptr) {}
+
+room_content& room::edit_content() {
+    if (content.use_count() > 1) {
+        content = std::make_shared<room_content>(*content);
+    }
+    return *content;
+}
 
 void room::set_name(const std::string& room_name) {
-    name = room_name;
+    edit_content().name = room_name;
 }
 
-std::string room::get_name() const {
-    return name;
+const std::string& room::get_name() const {
+    return content->name;
 }
 
 void room::set_short_description(const std::string& desc) {
-    short_description = desc;
+    edit_content().short_description = desc;
 }
 
-std::string room::get_short_description() const {
-    return short_description;
+const std::string& room::get_short_description() const {
+    return content->short_description;
 }
 
 void room::set_long_description(const std::string& desc) {
-    long_description = desc;
+    edit_content().long_description = desc;
 }
 
-std::string room::get_long_description() const {
-    return long_description;
+const std::string& room::get_long_description() const {
+    return content->long_description;
 }
 
 void room::set_type(const std::string& room_type) {
-    type = room_type;
+    edit_content().type = room_type;
+}
+
+const std::string& room::get_type() const {
+    return content->type;
 }
 
-std::string room::get_type() const {
-    return type;
+const std::string& room::get_id() const {
+    return id.str();
 }
 
-std::string room::get_id() const {
+symbol room::get_id_symbol() const {
     return id;
 }
 
 void room::add_connection(const std::string& direction, const std::string& room_id, const std::string& required_item) {
-    connections[direction] = room_connection(room_id, required_item);
+    add_connection(symbol_table::intern(direction), symbol_table::intern(room_id), symbol_table::intern(required_item));
+}
+
+void room::add_connection(symbol direction, symbol room_id, symbol required_item) {
+    auto it = content->connections.find(direction);
+    if (it != content->connections.end() &&
+        it->second.room_id == room_id && it->second.requires_ == required_item) {
+        return;
+    }
+    room_content& editable = edit_content();
+    room_connection& connection = editable.connections[direction];
+    connection = room_connection(room_id, required_item);
+    exit_direction compass;
+    if (exit_direction_of(direction, compass)) {
+        editable.exits[static_cast<size_t>(compass)] = connection;
+    }
+    modified = true;
+    if (navigation) {
+        navigation->invalidate();
+    }
+    if (journal) {
+        journal->connection_changed(id, direction, connection);
+    }
 }
 
 void room::unlock_connection(const std::string& direction) {
-    auto it = connections.find(direction);
-    if (it != connections.end()) {
-        it->second.requires_ = ""; 
+    symbol direction_symbol;
+    if (symbol_table::lookup(direction, direction_symbol)) {
+        unlock_connection(direction_symbol);
     }
 }
 
-const std::unordered_map<std::string, room_connection>& room::get_connections() const {
-    return connections;
+void room::unlock_connection(symbol direction) {
+    auto it = content->connections.find(direction);
+    if (it != content->connections.end() && !it->second.requires_.empty()) {
+        room_content& editable = edit_content();
+        room_connection& connection = editable.connections[direction];
+        connection.requires_ = symbol();
+        exit_direction compass;
+        if (exit_direction_of(direction, compass)) {
+            editable.exits[static_cast<size_t>(compass)].requires_ = symbol();
+        }
+        modified = true;
+        if (navigation) {
+            navigation->invalidate();
+        }
+        if (journal) {
+            journal->connection_changed(id, direction, connection);
+        }
+    }
+}
+
+const std::unordered_map<symbol, room_connection>& room::get_connections() const {
+    return content->connections;
+}
+
+const room_connection* room::find_connection(symbol direction) const {
+    exit_direction compass;
+    if (exit_direction_of(direction, compass)) {
+        return find_exit(compass);
+    }
+
+    auto it = content->connections.find(direction);
+    if (it != content->connections.end()) {
+        return &it->second;
+    }
+    return nullptr;
+}
+
+const room_connection* room::find_exit(exit_direction direction) const {
+    const room_connection& connection = content->exits[static_cast<size_t>(direction)];
+    return connection.room_id.empty() ? nullptr : &connection;
 }
 
 void room::add_feature(const std::string& feature) {
-    features.push_back(feature);
+    edit_content().features.push_back(feature);
 }
 
 const std::vector<std::string>& room::get_features() const {
-    return features;
+    return content->features;
 }
 
 void room::add_puzzle(const puzzle& new_puzzle) {
-    puzzles.push_back(new_puzzle);
+    edit_content().puzzles.push_back(new_puzzle);
 }
 
 const std::vector<puzzle>& room::get_puzzles() const {
-    return puzzles;
+    return content->puzzles;
 }
 
 bool room::solve_puzzle(const std::string& puzzle_id) {
-    for (auto& puzzle : puzzles) {
-        if (puzzle.id == puzzle_id) {
-            puzzle.solved = true;
+    const auto& puzzles = content->puzzles;
+    for (size_t i = 0; i < puzzles.size(); ++i) {
+        if (puzzles[i].id == puzzle_id) {
+            if (solved_puzzles.size() < puzzles.size()) {
+                solved_puzzles.resize(puzzles.size(), false);
+            }
+            solved_puzzles[i] = true;
+            modified = true;
+            if (journal) {
+                journal->puzzle_solved(id, symbol_table::intern(puzzle_id));
+            }
             return true;
         }
     }
     return false;
 }
 
+bool room::is_puzzle_solved(const std::string& puzzle_id) const {
+    const auto& puzzles = content->puzzles;
+    for (size_t i = 0; i < puzzles.size() && i < solved_puzzles.size(); ++i) {
+        if (puzzles[i].id == puzzle_id) {
+            return solved_puzzles[i];
+        }
+    }
+    return false;
+}
+
+uint32_t room::get_puzzle_state(symbol puzzle_id) const {
+    for (const auto& entry : puzzle_states) {
+        if (entry.first == puzzle_id) {
+            return entry.second;
+        }
+    }
+    return 0;
+}
+
+void room::set_puzzle_state(symbol puzzle_id, uint32_t state) {
+    if (get_puzzle_state(puzzle_id) != state) {
+        modified = true;
+        if (journal) {
+            journal->puzzle_state_changed(id, puzzle_id, state);
+        }
+    }
+
+    for (auto& entry : puzzle_states) {
+        if (entry.first == puzzle_id) {
+            entry.second = state;
+            return;
+        }
+    }
+
+    if (state != 0) {
+        puzzle_states.push_back({ puzzle_id, state });
+    }
+}
+
+const std::vector<std::pair<symbol, uint32_t>>& room::get_puzzle_states() const {
+    return puzzle_states;
+}
+
+void room::clear_puzzle_states() {
+    bool any_solved = std::find(solved_puzzles.begin(), solved_puzzles.end(), true) != solved_puzzles.end();
+    if (journal) {
+        for (const auto& entry : puzzle_states) {
+            if (entry.second != 0) {
+                journal->puzzle_state_changed(id, entry.first, 0);
+            }
+        }
+        if (any_solved) {
+            journal->structure_changed();
+        }
+    }
+    if (!puzzle_states.empty() || any_solved) {
+        modified = true;
+    }
+    puzzle_states.clear();
+    solved_puzzles.clear();
+}
+
 bool room::visited() const {
     return has_visited;
 }
 
 void room::set_visited(bool visited) {
+    if (has_visited != visited) {
+        modified = true;
+        if (journal) {
+            journal->room_visited(id, visited);
+        }
+    }
     has_visited = visited;
 }
+
+bool room::is_modified() const {
+    return modified;
+}
+
+void room::clear_modified() {
+    modified = false;
+}
+
+void room::set_journal(world_journal* owner) {
+    journal = owner;
+}
+
+void room::set_navigation(nav_graph* graph) {
+    navigation = graph;
+}
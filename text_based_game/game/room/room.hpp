@@ -1,17 +1,26 @@
 #ifndef ROOM_HPP
 #define ROOM_HPP
 
+#include "exit_direction.hpp"
+#include "../symbol/symbol_table.hpp"
 #include "../includes.hpp"
 #include <string>
 #include <unordered_map>
 #include <vector>
+#include <array>
+#include <memory>
+#include <utility>
+#include <cstdint>
+
+class world_journal;
+class nav_graph;
 
 struct room_connection {
-    std::string room_id;
-    std::string requires_; 
+    symbol room_id;
+    symbol requires_; 
 
     room_connection() = default;
-    room_connection(const std::string& id, const std::string& req = "") :
+    room_connection(symbol id, symbol req = symbol()) :
         room_id(id), requires_(req) {}
 };
 
@@ -27,43 +36,59 @@ struct puzzle {
     std::string reward_item;
     std::string unlocks_path;
     std::string sets_flag;
-    bool solved;
-
-    puzzle() : solved(false) {}
 };
 
-class room {
-private:
-    std::string id;
+struct room_content {
     std::string name;
     std::string short_description;
     std::string long_description;
     std::string type;
-    std::unordered_map<std::string, room_connection> connections;
+    std::unordered_map<symbol, room_connection> connections;
+    std::array<room_connection, exit_direction_count> exits;
     std::vector<std::string> features;
     std::vector<puzzle> puzzles;
+};
+
+class room {
+private:
+    symbol id;
+    std::shared_ptr<room_content> content;
+    std::vector<bool> solved_puzzles;
+    std::vector<std::pair<symbol, uint32_t>> puzzle_states;
     bool has_visited;
+    bool modified;
+    world_journal* journal;
+    nav_graph* navigation;
+
+    room_content& edit_content();
 
 public:
     room(const std::string& id);
+    room(symbol id);
+    room(symbol id, std::shared_ptr<room_content> initial_content);
 
     void set_name(const std::string& name);
-    std::string get_name() const;
+    const std::string& get_name() const;
 
     void set_short_description(const std::string& desc);
-    std::string get_short_description() const;
+    const std::string& get_short_description() const;
 
     void set_long_description(const std::string& desc);
-    std::string get_long_description() const;
+    const std::string& get_long_description() const;
 
     void set_type(const std::string& type);
-    std::string get_type() const;
+    const std::string& get_type() const;
 
-    std::string get_id() const;
+    const std::string& get_id() const;
+    symbol get_id_symbol() const;
 
     void add_connection(const std::string& direction, const std::string& room_id, const std::string& required_item = "");
+    void add_connection(symbol direction, symbol room_id, symbol required_item = symbol());
     void unlock_connection(const std::string& direction);
-    const std::unordered_map<std::string, room_connection>& get_connections() const;
+    void unlock_connection(symbol direction);
+    const std::unordered_map<symbol, room_connection>& get_connections() const;
+    const room_connection* find_connection(symbol direction) const;
+    const room_connection* find_exit(exit_direction direction) const;
 
     void add_feature(const std::string& feature);
     const std::vector<std::string>& get_features() const;
@@ -71,9 +96,21 @@ public:
     void add_puzzle(const puzzle& new_puzzle);
     const std::vector<puzzle>& get_puzzles() const;
     bool solve_puzzle(const std::string& puzzle_id);
+    bool is_puzzle_solved(const std::string& puzzle_id) const;
+
+    uint32_t get_puzzle_state(symbol puzzle_id) const;
+    void set_puzzle_state(symbol puzzle_id, uint32_t state);
+    const std::vector<std::pair<symbol, uint32_t>>& get_puzzle_states() const;
+    void clear_puzzle_states();
 
     bool visited() const;
     void set_visited(bool visited);
+
+    bool is_modified() const;
+    void clear_modified();
+
+    void set_journal(world_journal* owner);
+    void set_navigation(nav_graph* graph);
 };
 
 #endif 
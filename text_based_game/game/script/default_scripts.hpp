@@ -0,0 +1,68 @@
+#ifndef DEFAULT_SCRIPTS_HPP
+#define DEFAULT_SCRIPTS_HPP
+
+static const char default_scripts[] =
+R"json({
+    "rules": [
+)json"
+R"json(        {"room": "sanctum_whispers", "verbs": ["examine", "look"], "objects": ["western wall", "western", "wall", "walls"], "object_contains": ["wall"], "do": [{"say": "The western wall is covered in ornate runes. You notice that some of them - colored blue, red, and green - seem to react to your presence."}]},
+        {"room": "sanctum_whispers", "verbs": ["examine", "look"], "objects": ["runes", "glowing runes"], "object_contains": ["rune"], "do": [{"say": "The glowing runes pulse with an otherworldly light. Three runes stand out: one blue, one red, and one green."}]},
+)json"
+R"json(        {"room": "clockwork_forge", "trigger": "always", "when": [{"item_missing": "large_gear"}], "do": [{"spawn_item": "large_gear", "name": "Large Gear", "description": "A hefty metal gear that appears to be part of a mechanism.", "type": "part", "location": "clockwork_forge"}]},
+        {"room": "clockwork_forge", "trigger": "always", "when": [{"item_missing": "medium_gear"}], "do": [{"spawn_item": "medium_gear", "name": "Medium Gear", "description": "A medium-sized gear with intricate teeth.", "type": "part", "location": "clockwork_forge"}]},
+        {"room": "clockwork_forge", "trigger": "always", "when": [{"item_missing": "small_gear"}], "do": [{"spawn_item": "small_gear", "name": "Small Gear", "description": "A small but precisely crafted gear.", "type": "part", "location": "clockwork_forge"}]},
+        {"room": "clockwork_forge", "trigger": "always", "when": [{"item_missing": "crystal_fragment_1"}, {"flag": "bridge_puzzle_solved"}], "do": [{"spawn_item": "crystal_fragment_1", "name": "Crystal Fragment 1", "description": "A glowing fragment of the Echo Crystal.", "type": "quest_item", "location": "clockwork_forge"}]},
+        {"room": "clockwork_forge", "trigger": "always", "when": [{"item_missing": "crystal_fragment_1"}], "do": [{"spawn_item": "crystal_fragment_1", "name": "Crystal Fragment 1", "description": "A glowing fragment of the Echo Crystal.", "type": "quest_item", "location": "hidden"}]},
+        {"room": "clockwork_forge", "trigger": "always", "when": [{"flag": "bridge_puzzle_solved"}, {"item_not_at": "crystal_fragment_1", "in": ["clockwork_forge", "inventory", "placed", "echo_chamber"]}], "do": [{"move_item": "crystal_fragment_1", "to": "clockwork_forge"}]},
+        {"room": "clockwork_forge", "trigger": "always", "when": [{"not_flag": "bridge_puzzle_solved"}, {"item_not_at": "crystal_fragment_1", "in": ["hidden", "inventory", "placed", "echo_chamber"]}], "do": [{"move_item": "crystal_fragment_1", "to": "hidden"}]},
+        {"room": "clockwork_forge", "verbs": ["examine", "look"], "objects": ["gear bridge", "bridge", "gear_bridge"], "do": [{"if": [{"flag": "bridge_puzzle_solved"}], "then": [{"say": "The gear bridge is now fully operational, providing a sturdy path across the chasm. On the far side, you can see a Crystal Fragment glinting in the light."}], "else": [{"say": "A massive mechanism spans a chasm in the center of the forge. It appears to be a bridge, but several key gears are missing from its workings. Through the gap, you can see something glittering on the other side."}]}]},
+        {"room": "clockwork_forge", "verbs": ["examine", "look"], "objects": ["mechanical workbench", "workbench", "mechanical_workbench"], "do": [{"say": "A sturdy workbench covered with tools and mechanical parts. Various gears of different sizes are scattered across its surface."}]},
+)json"
+R"json(        {"room": "archive_shadows", "trigger": "always", "when": [{"npc_missing": "librarian"}], "do": [{"spawn_npc": "librarian", "name": "The Librarian", "description": "A spectral entity in the Archive of Shadows", "role": "Knowledge Keeper", "room": "archive_shadows"}]},
+        {"room": "archive_shadows", "trigger": "always", "do": [{"move_npc": "librarian", "to": "archive_shadows"}]},
+        {"room": "archive_shadows", "trigger": "always", "when": [{"item_missing": "ancient_tome"}], "do": [{"spawn_item": "ancient_tome", "name": "Ancient Tome", "description": "Contains cryptic knowledge about the Echo Crystal", "type": "book", "location": "archive_shadows", "properties": {"readable": true, "contents": "The Echo Crystal was shattered during the Great Cataclysm. Its five fragments were scattered across Aetheria. Only by reuniting them can balance be restored."}}]},
+        {"room": "archive_shadows", "trigger": "always", "when": [{"item_missing": "crystal_fragment_2"}], "do": [{"spawn_item": "crystal_fragment_2", "name": "Crystal Fragment 2", "description": "A glowing fragment of the Echo Crystal.", "type": "quest_item", "location": "archive_shadows"}]},
+        {"room": "archive_shadows", "trigger": "always", "when": [{"item_not_at": "crystal_fragment_2", "in": ["archive_shadows", "inventory", "echo_chamber"]}], "do": [{"move_item": "crystal_fragment_2", "to": "archive_shadows"}]},
+        {"room": "archive_shadows", "verbs": ["examine", "look"], "objects": ["librarian", "the librarian"], "do": [{"say": "A ghostly figure drifts among the bookshelves. Its form shifts and wavers, but two piercing eyes remain constant, studying you with ancient wisdom."}]},
+        {"room": "archive_shadows", "verbs": ["talk"], "objects": ["librarian", "the librarian"], "do": [{"say": "The Librarian: \"Knowledge has a price, seeker. Bring me the Ancient Tome, and I shall share what I know.\"\n\nWhat do you say?\n1: I'll find the tome for you.\n2: What knowledge do you possess?"}, {"prompt": {"1": [{"say": "The Librarian: \"The tome rests among these shelves. Seek and you shall find.\""}], "2": [{"say": "The Librarian: \"I hold the secret history of Aetheria and the Echo Crystal. But such knowledge is not freely given.\""}]}}, {"if": [{"has_item": "ancient_tome"}], "then": [{"say": "\nThe Librarian notices the Ancient Tome in your possession.\nThe Librarian: \"Ah, you have brought the tome. As promised, I shall reveal what I know.\"\nThe Librarian tells you about the locations of the Crystal Fragments and the history of the Echo Crystal.\nThe Librarian: \"Take this fragment as a token of our exchange. The others await in Ember Peaks, Abyssal Trench, and Veyra's Airship.\""}]}]},
+        {"room": "archive_shadows", "verbs": ["examine", "look"], "objects": ["book", "tome", "ancient tome"], "do": [{"say": "A weathered tome bound in strange material. Ancient runes decorate its cover, and it seems to emanate a subtle glow."}]},
+        {"room": "archive_shadows", "verbs": ["examine", "look"], "objects": ["bookshelves", "shelves", "books"], "do": [{"say": "Rows upon rows of ancient tomes line the shelves. Among them, you notice a particularly ornate book that seems to be glowing faintly."}]},
+)json"
+R"json(        {"room": "ember_peaks", "trigger": "always", "when": [{"npc_missing": "gorath"}], "do": [{"spawn_npc": "gorath", "name": "Gorath", "description": "A cursed knight trapped in enchanted armor", "role": "Cursed Knight", "room": "ember_peaks"}]},
+        {"room": "ember_peaks", "trigger": "always", "do": [{"move_npc": "gorath", "to": "ember_peaks"}]},
+        {"room": "ember_peaks", "trigger": "always", "when": [{"item_missing": "crystal_fragment_3"}], "do": [{"spawn_item": "crystal_fragment_3", "name": "Crystal Fragment 3", "description": "A glowing fragment of the Echo Crystal.", "type": "quest_item", "location": "ember_peaks"}]},
+        {"room": "ember_peaks", "trigger": "always", "when": [{"item_not_at": "crystal_fragment_3", "in": ["ember_peaks", "inventory", "echo_chamber"]}], "do": [{"move_item": "crystal_fragment_3", "to": "ember_peaks"}]},
+        {"room": "ember_peaks", "verbs": ["talk"], "objects": ["gorath", "knight"], "do": [{"if": [{"flag": "gorath_riddle_solved"}], "then": [{"say": "Gorath: \"You have proven worthy of the crystal's power. Use it wisely.\""}], "else": [{"say": "Gorath: \"Answer my riddle or face me in combat.\"\nGorath: \"I am not alive, but I grow; I don't have lungs, but I need air; I don't have a mouth, but water kills me. What am I?\"\n\nWhat is your answer?"}, {"prompt": {"fire": [{"say": "Gorath: \"Correct! You have proven your wisdom.\"\nGorath presents you with the Crystal Fragment as promised."}, {"set_flag": "gorath_riddle_solved"}]}, "otherwise": [{"say": "Gorath: \"Incorrect. Try again when you have discovered the answer.\""}]}]}]},
+        {"room": "ember_peaks", "verbs": ["fire", "answer"], "objects": [""], "do": [{"if": [{"not_flag": "gorath_riddle_solved"}], "then": [{"say": "Gorath: \"Correct! You have proven your wisdom.\"\nGorath presents you with the Crystal Fragment as promised."}, {"set_flag": "gorath_riddle_solved"}], "else": [{"say": "Gorath has already given you the Crystal Fragment."}]}]},
+        {"room": "ember_peaks", "verbs": ["answer"], "objects": ["fire"], "do": [{"if": [{"not_flag": "gorath_riddle_solved"}], "then": [{"say": "Gorath: \"Correct! You have proven your wisdom.\"\nGorath presents you with the Crystal Fragment as promised."}, {"set_flag": "gorath_riddle_solved"}], "else": [{"say": "Gorath has already given you the Crystal Fragment."}]}]},
+)json"
+R"json(        {"room": "skyward_nexus", "trigger": "always", "when": [{"item_missing": "echo_amulet"}], "do": [{"spawn_item": "echo_amulet", "name": "Echo Amulet", "description": "Allows glimpses into past events", "type": "artifact", "location": "skyward_nexus"}]},
+        {"room": "skyward_nexus", "verbs": ["examine", "look"], "objects": ["floating paths", "paths", "floating_paths"], "do": [{"if": [{"flag": "paths_aligned"}], "then": [{"say": "The floating pathways now form a stable network, allowing access to all the islands."}], "else": [{"say": "Translucent pathways float in the air, connecting to different islands. They seem to shift and waver, making some destinations difficult to reach."}]}]},
+        {"room": "skyward_nexus", "verbs": ["use"], "objects": ["echo amulet", "amulet", "echo_amulet"], "do": [{"say": "The amulet glows with an inner light. Ghostly images of the past appear, showing how the pathways were originally arranged."}]},
+        {"room": "skyward_nexus", "verbs": ["activate"], "objects": ["path alignment", "paths", "path_alignment"], "do": [{"if": [{"any": [{"has_item": "echo_amulet"}, {"item_at": "echo_amulet", "in": "inventory"}]}], "then": [{"say": "Using the Echo Amulet's visions as a guide, you realign the floating paths. The pathways solidify into a stable network, allowing access to all islands."}], "else": [{"say": "You concentrate on aligning the floating paths. After some trial and error, the pathways solidify into a stable network, allowing access to all islands."}]}, {"set_flag": "paths_aligned"}, {"unlock": "skyward_nexus", "directions": ["north", "south", "east", "west", "up", "down"]}]},
+        {"room": "skyward_nexus", "verbs": ["take"], "objects": ["echo amulet", "amulet", "echo_amulet"], "do": [{"if": [{"item_not_at": "echo_amulet", "in": ["skyward_nexus", "inventory"]}], "then": [{"move_item": "echo_amulet", "to": "skyward_nexus"}]}, {"give_item": "echo_amulet", "success": "Taken.", "failure": "You can't carry any more items."}]},
+)json"
+R"json(        {"room": "veyras_airship", "trigger": "always", "when": [{"npc_missing": "veyra"}], "do": [{"spawn_npc": "veyra", "name": "Veyra", "description": "A rogue inventor seeking the Echo Crystal to power her airship", "role": "Rogue Inventor", "room": "veyras_airship"}]},
+        {"room": "veyras_airship", "trigger": "always", "do": [{"move_npc": "veyra", "to": "veyras_airship"}]},
+        {"room": "veyras_airship", "trigger": "always", "when": [{"item_missing": "crystal_fragment_5"}], "do": [{"spawn_item": "crystal_fragment_5", "name": "Crystal Fragment 5", "description": "A glowing fragment of the Echo Crystal.", "type": "quest_item", "location": "veyras_airship"}]},
+        {"room": "veyras_airship", "trigger": "always", "when": [{"item_not_at": "crystal_fragment_5", "in": ["veyras_airship", "inventory", "echo_chamber"]}], "do": [{"move_item": "crystal_fragment_5", "to": "veyras_airship"}]},
+        {"room": "veyras_airship", "verbs": ["examine", "look"], "objects": ["veyra", "inventor"], "do": [{"say": "A sharp-eyed woman dressed in gear-laden attire. Various tools hang from her belt, and she studies you with a calculating gaze."}]},
+        {"room": "veyras_airship", "verbs": ["talk"], "objects": ["veyra", "inventor"], "do": [{"say": "Veyra: \"Perhaps we can help each other, stranger. I need Crystal fragments for my research.\"\n\nWhat do you say?\n1: What research are you conducting?\n2: I'm collecting the fragments myself."}, {"prompt": {"1": [{"say": "Veyra: \"I'm studying how to harness the Crystal's energy for my airship. The technology could revolutionize travel across the shattered isles.\""}], "2": [{"say": "Veyra: \"I see. Well, perhaps we can still aid each other. I'll let you take the fragment here if you promise to share what you learn about the Crystal.\""}]}}, {"set_flag": "veyra_negotiation_complete"}]},
+)json"
+R"json(        {"room": "abyssal_trench", "trigger": "always", "when": [{"item_missing": "crystal_fragment_4"}], "do": [{"spawn_item": "crystal_fragment_4", "name": "Crystal Fragment 4", "description": "A glowing fragment of the Echo Crystal.", "type": "quest_item", "location": "abyssal_trench"}]},
+        {"room": "abyssal_trench", "trigger": "always", "when": [{"item_not_at": "crystal_fragment_4", "in": ["abyssal_trench", "inventory", "echo_chamber"]}], "do": [{"move_item": "crystal_fragment_4", "to": "abyssal_trench"}]},
+        {"room": "abyssal_trench", "trigger": "always", "when": [{"item_missing": "pressure_gauge"}], "do": [{"spawn_item": "pressure_gauge", "name": "Pressure Gauge", "description": "A device for measuring underwater pressure", "type": "tool", "location": "abyssal_trench"}]},
+        {"room": "abyssal_trench", "verbs": ["examine", "look"], "objects": ["water spirit", "spirit"], "do": [{"say": "A shimmering presence made of pure water. It moves gracefully through the depths, occasionally forming a face to observe you."}]},
+        {"room": "abyssal_trench", "verbs": ["use"], "objects": ["pressure gauge", "gauge", "pressure_gauge"], "do": [{"say": "You use the pressure gauge to measure the water pressure at different depths. The readings reveal a pattern that could be used to stabilize the currents."}]},
+        {"room": "abyssal_trench", "verbs": ["activate"], "objects": ["pressure control", "pressure_control"], "do": [{"if": [{"any": [{"has_item": "pressure_gauge"}, {"item_at": "pressure_gauge", "in": "inventory"}]}], "then": [{"say": "Using the pressure gauge readings, you adjust the ancient mechanism. The water currents stabilize, revealing a hidden chamber containing the Crystal Fragment."}], "else": [{"say": "You adjust various controls on the ancient mechanism. By luck or intuition, the water currents stabilize, revealing a hidden chamber containing the Crystal Fragment."}]}, {"set_flag": "pressure_puzzle_solved"}]},
+)json"
+R"json(        {"room": "echo_chamber", "trigger": "always", "when": [{"npc_missing": "architect"}], "do": [{"spawn_npc": "architect", "name": "The Architect", "description": "A mysterious figure who appears in visions", "role": "Mysterious Figure", "room": "echo_chamber"}]},
+        {"room": "echo_chamber", "trigger": "always", "do": [{"move_npc": "architect", "to": "echo_chamber"}]},
+        {"room": "echo_chamber", "verbs": ["examine", "look"], "objects": ["crystal altar", "altar"], "do": [{"say": "A translucent altar floats at the center of the chamber. Five indentations are visible, perfectly shaped to hold the Crystal Fragments."}]},
+        {"room": "echo_chamber", "verbs": ["use"], "object_contains": ["crystal fragment", "crystal_fragment"], "do": [{"if": [{"holds_at_least": 3, "items": ["crystal_fragment_1", "crystal_fragment_2", "crystal_fragment_3", "crystal_fragment_4", "crystal_fragment_5"]}], "then": [{"say": "You place all your Crystal Fragments on the altar. They begin to glow intensely, rising into the air and drawing together. With a flash of light, they merge into the complete Echo Crystal."}, {"set_flag": "crystal_restored"}, {"spawn_item": "echo_crystal", "name": "Echo Crystal", "description": "The restored Echo Crystal, pulsing with otherworldly power.", "type": "artifact", "location": "echo_chamber"}, {"remove_items": ["crystal_fragment_1", "crystal_fragment_2", "crystal_fragment_3", "crystal_fragment_4", "crystal_fragment_5"]}], "else": [{"say": "You place the fragment on the altar, but nothing happens. It seems you need more fragments to restore the Crystal."}]}]},
+        {"room": "echo_chamber", "verbs": ["talk"], "objects": ["architect", "the architect"], "do": [{"if": [{"flag": "crystal_restored"}], "then": [{"say": "The Architect: \"You must choose the fate of Aetheria.\"\n\nThe Architect presents you with three choices:\n1: Restore balance and sacrifice yourself\n2: Seize power and reshape reality\n3: Shatter the crystal and end the cycle"}, {"prompt": {"1": [{"say": "\nYou channel the Crystal's power, sacrificing your own existence to restore Aetheria.\nThe shattered islands begin to rejoin, and balance returns to the world.\nThough you cease to exist in this timeline, your legacy lives on in the restored realm.\n\n*** THE END - RESTORATION ENDING ***"}], "2": [{"say": "\nYou absorb the Crystal's power, becoming a godlike entity.\nReality bends to your will as you reshape Aetheria according to your vision.\nBut with such power comes consequences that even you cannot foresee...\n\n*** THE END - DOMINATION ENDING ***"}], "3": [{"say": "\nYou shatter the newly-restored Crystal, breaking the cycle permanently.\nThe fragments dissolve into pure energy, dispersing throughout Aetheria.\nThe world will never be whole again, but neither will it be bound by ancient powers.\n\n*** THE END - OBLIVION ENDING ***"}]}}], "else": [{"if": [{"holds_at_least": 3, "items": ["crystal_fragment_1", "crystal_fragment_2", "crystal_fragment_3", "crystal_fragment_4", "crystal_fragment_5"]}], "then": [{"say": "The Architect: \"You have the fragments. Place them on the altar to restore the Crystal.\""}], "else": [{"say": "The Architect: \"The Crystal remains incomplete. Gather more fragments from across Aetheria and place them on the altar.\""}]}]}]}
+)json"
+R"json(    ]
+})json";
+
+#endif
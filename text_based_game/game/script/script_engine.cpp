@@ -0,0 +1,455 @@
+#include "script_engine.hpp"
+#include "../world/world.hpp"
+#include <iostream>
+#include <algorithm>
+
+uint64_t script_engine::dispatch_key(symbol room, symbol verb) {
+    return (static_cast<uint64_t>(room.index()) << 32) | verb.index();
+}
+
+void script_engine::add_rule(script_rule rule) {
+    rules.push_back(std::move(rule));
+}
+
+void script_engine::add_native(const std::string& room_id, const std::string& verb, native_handler handler) {
+    native_keys.push_back({ dispatch_key(symbol(room_id), symbol(verb)), natives.size() });
+    natives.push_back(std::move(handler));
+}
+
+void script_engine::compile() {
+    setup_rules.clear();
+    dispatch_table.clear();
+
+    for (size_t i = 0; i < rules.size(); ++i) {
+        const script_rule& rule = rules[i];
+        if (rule.always) {
+            setup_rules[rule.room].push_back(i);
+            continue;
+        }
+
+        for (symbol verb : rule.verbs) {
+            dispatch_table[dispatch_key(rule.room, verb)].push_back({ false, i });
+        }
+    }
+
+    for (const auto& key : native_keys) {
+        dispatch_table[key.first].push_back({ true, key.second });
+    }
+}
+
+size_t script_engine::get_rule_count() const {
+    return rules.size();
+}
+
+void script_engine::run_setup(world& game_world, room& current_room, player& player) const {
+    auto it = setup_rules.find(current_room.get_id_symbol());
+    if (it == setup_rules.end()) {
+        return;
+    }
+
+    for (size_t index : it->second) {
+        const script_rule& rule = rules[index];
+        if (check_all(rule.conditions, game_world, player)) {
+            apply_all(rule.effects, game_world, player);
+        }
+    }
+}
+
+bool script_engine::dispatch(world& game_world, room& current_room, player& player,
+    std::string_view verb, std::string_view object) const {
+    symbol verb_symbol;
+    if (!symbol_table::lookup(verb, verb_symbol)) {
+        return false;
+    }
+
+    auto it = dispatch_table.find(dispatch_key(current_room.get_id_symbol(), verb_symbol));
+    if (it == dispatch_table.end()) {
+        return false;
+    }
+
+    for (const auto& target : it->second) {
+        if (target.native) {
+            if (natives[target.index](game_world, current_room, player, object)) {
+                return true;
+            }
+            continue;
+        }
+
+        const script_rule& rule = rules[target.index];
+        if (matches_object(rule, object) && check_all(rule.conditions, game_world, player)) {
+            apply_all(rule.effects, game_world, player);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool script_engine::matches_object(const script_rule& rule, std::string_view object) {
+    if (rule.objects.empty() && rule.object_contains.empty()) {
+        return true;
+    }
+
+    for (const auto& candidate : rule.objects) {
+        if (candidate == object) {
+            return true;
+        }
+    }
+
+    for (const auto& fragment : rule.object_contains) {
+        if (object.find(fragment) != std::string_view::npos) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool script_engine::check_all(const std::vector<script_condition>& conditions, const world& game_world, const player& player) {
+    for (const auto& condition : conditions) {
+        if (!check(condition, game_world, player)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool script_engine::check(const script_condition& condition, const world& game_world, const player& player) {
+    switch (condition.type) {
+    case script_condition_type::flag:
+        return game_world.get_game_flag(condition.subject);
+    case script_condition_type::not_flag:
+        return !game_world.get_game_flag(condition.subject);
+    case script_condition_type::has_item:
+        return player.get_item_from_inventory(condition.subject.str()) != nullptr;
+    case script_condition_type::item_missing:
+        return !game_world.get_item(condition.subject);
+    case script_condition_type::npc_missing:
+        return !game_world.get_npc(condition.subject);
+    case script_condition_type::item_at:
+    case script_condition_type::item_not_at: {
+        auto item_ptr = game_world.get_item(condition.subject);
+        if (!item_ptr) {
+            return false;
+        }
+
+        bool found = std::find(condition.places.begin(), condition.places.end(),
+            item_ptr->get_location_symbol()) != condition.places.end();
+        return condition.type == script_condition_type::item_at ? found : !found;
+    }
+    case script_condition_type::holds_at_least: {
+        int held = 0;
+        for (symbol item_id : condition.items) {
+            if (player.get_item_from_inventory(item_id.str())) {
+                held++;
+            }
+        }
+        return held >= condition.count;
+    }
+    case script_condition_type::any:
+        for (const auto& alternative : condition.alternatives) {
+            if (check(alternative, game_world, player)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    return false;
+}
+
+void script_engine::apply_all(const std::vector<script_effect>& effects, world& game_world, player& player) {
+    for (const auto& effect : effects) {
+        apply(effect, game_world, player);
+    }
+}
+
+void script_engine::apply(const script_effect& effect, world& game_world, player& player) {
+    switch (effect.type) {
+    case script_effect_type::say:
+        std::cout << effect.text << std::endl;
+        break;
+
+    case script_effect_type::set_flag:
+        game_world.set_game_flag(effect.subject, true);
+        break;
+
+    case script_effect_type::clear_flag:
+        game_world.set_game_flag(effect.subject, false);
+        break;
+
+    case script_effect_type::move_item: {
+        auto item_ptr = game_world.get_item(effect.subject);
+        if (item_ptr) {
+            item_ptr->set_location(effect.place);
+        }
+        break;
+    }
+
+    case script_effect_type::spawn_item: {
+        auto new_item = game_world.create_item(effect.subject);
+        new_item->set_name(effect.name);
+        new_item->set_description(effect.description);
+        new_item->set_type(effect.kind);
+        for (const auto& property : effect.properties) {
+            new_item->set_property(property.first, property.second);
+        }
+        new_item->set_location(effect.place);
+        game_world.add_item(new_item);
+        break;
+    }
+
+    case script_effect_type::give_item: {
+        auto item_ptr = game_world.get_item(effect.subject);
+        if (item_ptr && player.add_to_inventory(item_ptr)) {
+            std::cout << effect.text << std::endl;
+        }
+        else {
+            std::cout << effect.failure_text << std::endl;
+        }
+        break;
+    }
+
+    case script_effect_type::remove_items:
+        for (symbol item_id : effect.targets) {
+            player.remove_from_inventory(item_id.str());
+        }
+        break;
+
+    case script_effect_type::spawn_npc: {
+        auto new_npc = game_world.create_npc(effect.subject.str());
+        new_npc->set_name(effect.name);
+        new_npc->set_description(effect.description);
+        new_npc->set_role(effect.kind);
+        new_npc->set_current_room(effect.place);
+        game_world.add_npc(new_npc);
+        break;
+    }
+
+    case script_effect_type::move_npc: {
+        auto npc_ptr = game_world.get_npc(effect.subject);
+        if (npc_ptr && npc_ptr->get_current_room_symbol() != effect.place) {
+            npc_ptr->set_current_room(effect.place);
+        }
+        break;
+    }
+
+    case script_effect_type::unlock: {
+        auto room_ptr = game_world.get_room(effect.subject);
+        if (room_ptr) {
+            for (symbol direction : effect.targets) {
+                room_ptr->unlock_connection(direction);
+            }
+        }
+        break;
+    }
+
+    case script_effect_type::prompt: {
+        std::string answer;
+        std::cout << "> ";
+        std::getline(std::cin, answer);
+        std::transform(answer.begin(), answer.end(), answer.begin(),
+            [](unsigned char c) { return std::tolower(c); });
+
+        for (const auto& choice : effect.answers) {
+            if (choice.first == answer) {
+                apply_all(choice.second, game_world, player);
+                return;
+            }
+        }
+        apply_all(effect.else_effects, game_world, player);
+        break;
+    }
+
+    case script_effect_type::branch:
+        if (check_all(effect.conditions, game_world, player)) {
+            apply_all(effect.then_effects, game_world, player);
+        }
+        else {
+            apply_all(effect.else_effects, game_world, player);
+        }
+        break;
+    }
+}
+
+namespace {
+    const symbol rune_puzzle("rune_sequence");
+    const symbol gear_puzzle("bridge_gears");
+    const symbol sanctum_flag("sanctum_puzzle_solved");
+    const symbol bridge_flag("bridge_puzzle_solved");
+
+    const uint32_t rune_count_mask = 0x3;
+    const uint32_t rune_solution = (1u << 2) | (2u << 4) | (3u << 6);
+    const uint32_t puzzle_complete = 1u << 31;
+
+    const uint32_t large_gear_placed = 1u << 0;
+    const uint32_t medium_gear_placed = 1u << 1;
+    const uint32_t small_gear_placed = 1u << 2;
+
+    uint32_t rune_code(std::string_view colour) {
+        if (colour == "blue") return 1;
+        if (colour == "red") return 2;
+        if (colour == "green") return 3;
+        return 0;
+    }
+
+    void place_gear(world& game_world, room& forge, player& player, const std::string& gear_id, uint32_t gear_bit) {
+        forge.set_puzzle_state(gear_puzzle, forge.get_puzzle_state(gear_puzzle) | gear_bit);
+
+        auto gear = game_world.get_item(gear_id);
+        if (gear && player.remove_from_inventory(gear_id)) {
+            gear->set_location("placed");
+        }
+    }
+
+    bool activate_rune(world& game_world, room& sanctum, player& player, std::string_view object) {
+        uint32_t state = sanctum.get_puzzle_state(rune_puzzle);
+
+        if (state & puzzle_complete) {
+            std::cout << "The runes have already been activated." << std::endl;
+            return true;
+        }
+
+        uint32_t code = rune_code(object);
+        if (code == 0) {
+            return false;
+        }
+
+        uint32_t count = state & rune_count_mask;
+        state = (state & ~rune_count_mask) | (code << (2 + 2 * count)) | (count + 1);
+        std::cout << "The " << object << " rune glows brightly as you activate it." << std::endl;
+
+        if (count + 1 == 3) {
+            if ((state & ~rune_count_mask) == rune_solution) {
+                std::cout << "The combination of runes triggers a mechanism in the wall. "
+                    << "A hidden compartment opens, revealing a Clockwork Key!" << std::endl;
+
+                auto key = game_world.get_item("clockwork_key");
+                if (key) {
+                    key->set_location(player.get_current_room_symbol());
+                }
+                else {
+                    auto new_key = game_world.create_item(symbol("clockwork_key"));
+                    new_key->set_name("Clockwork Key");
+                    new_key->set_description("A brass key used to operate steampunk machinery.");
+                    new_key->set_type("key");
+                    new_key->set_location(player.get_current_room_symbol());
+                    game_world.add_item(new_key);
+                }
+
+                state = puzzle_complete;
+                game_world.set_game_flag(sanctum_flag, true);
+            }
+            else {
+                std::cout << "The runes flash briefly, then fade. That combination didn't work." << std::endl;
+                state = 0;
+            }
+        }
+
+        sanctum.set_puzzle_state(rune_puzzle, state);
+        return true;
+    }
+
+    bool use_gear(world& game_world, room& forge, player& player, std::string_view object) {
+        uint32_t placed = forge.get_puzzle_state(gear_puzzle);
+
+        if (object == "large gear" || object == "large_gear") {
+            std::cout << "You place the large gear into the main mechanism of the bridge. "
+                << "It fits perfectly into the central housing." << std::endl;
+            place_gear(game_world, forge, player, "large_gear", large_gear_placed);
+            return true;
+        }
+
+        if (object == "medium gear" || object == "medium_gear") {
+            if (!(placed & large_gear_placed)) {
+                std::cout << "You need to place the large gear first." << std::endl;
+            }
+            else {
+                std::cout << "You attach the medium gear to the large one. "
+                    << "It meshes perfectly with the teeth of the larger gear." << std::endl;
+                place_gear(game_world, forge, player, "medium_gear", medium_gear_placed);
+            }
+            return true;
+        }
+
+        if (object == "small gear" || object == "small_gear") {
+            if (!(placed & medium_gear_placed)) {
+                std::cout << "You need to place the medium gear first." << std::endl;
+            }
+            else {
+                std::cout << "You insert the small gear into the final slot of the mechanism. "
+                    << "All the gears now form a complete chain." << std::endl;
+                place_gear(game_world, forge, player, "small_gear", small_gear_placed);
+            }
+            return true;
+        }
+
+        return false;
+    }
+
+    bool activate_bridge(world& game_world, room& forge, player&, std::string_view object) {
+        if (object != "bridge" && object != "gear bridge" && object != "bridge_repair") {
+            return false;
+        }
+
+        uint32_t all_gears = large_gear_placed | medium_gear_placed | small_gear_placed;
+        if ((forge.get_puzzle_state(gear_puzzle) & all_gears) == all_gears) {
+            std::cout << "With all gears in place, you activate the mechanism. "
+                << "The bridge extends fully across the chasm with a satisfying series of mechanical clicks." << std::endl;
+
+            std::cout << "As the bridge connects, you spot a Crystal Fragment glinting on the far side." << std::endl;
+
+            game_world.set_game_flag(bridge_flag, true);
+
+            auto fragment = game_world.get_item("crystal_fragment_1");
+            if (fragment) {
+                fragment->set_location("clockwork_forge");
+            }
+        }
+        else {
+            std::cout << "The bridge mechanism is still incomplete. You need to place all the gears." << std::endl;
+        }
+        return true;
+    }
+}
+
+void script_engine::add_builtin_natives() {
+    add_native("sanctum_whispers", "activate", activate_rune);
+    add_native("clockwork_forge", "use", use_gear);
+    add_native("clockwork_forge", "activate", activate_bridge);
+}
+
+void script_engine::collect_condition_flags(const std::vector<script_condition>& conditions, std::vector<symbol>& flags) {
+    for (const auto& condition : conditions) {
+        if (condition.type == script_condition_type::flag || condition.type == script_condition_type::not_flag) {
+            flags.push_back(condition.subject);
+        }
+        collect_condition_flags(condition.alternatives, flags);
+    }
+}
+
+void script_engine::collect_effect_flags(const std::vector<script_effect>& effects, std::vector<symbol>& flags) {
+    for (const auto& effect : effects) {
+        if (effect.type == script_effect_type::set_flag || effect.type == script_effect_type::clear_flag) {
+            flags.push_back(effect.subject);
+        }
+        for (const auto& answer : effect.answers) {
+            collect_effect_flags(answer.second, flags);
+        }
+        collect_condition_flags(effect.conditions, flags);
+        collect_effect_flags(effect.then_effects, flags);
+        collect_effect_flags(effect.else_effects, flags);
+    }
+}
+
+void script_engine::collect_flags(std::vector<symbol>& flags) const {
+    for (const auto& rule : rules) {
+        collect_condition_flags(rule.conditions, flags);
+        collect_effect_flags(rule.effects, flags);
+    }
+
+    if (!natives.empty()) {
+        flags.push_back(sanctum_flag);
+        flags.push_back(bridge_flag);
+    }
+}
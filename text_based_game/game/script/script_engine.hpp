@@ -0,0 +1,127 @@
+#ifndef SCRIPT_ENGINE_HPP
+#define SCRIPT_ENGINE_HPP
+
+#include "../item/item_property.hpp"
+#include "../symbol/symbol_table.hpp"
+#include "../includes.hpp"
+#include <string>
+#include <string_view>
+#include <vector>
+#include <utility>
+#include <functional>
+#include <unordered_map>
+#include <cstdint>
+
+class world;
+class room;
+class player;
+
+enum class script_condition_type {
+    flag,
+    not_flag,
+    has_item,
+    item_missing,
+    npc_missing,
+    item_at,
+    item_not_at,
+    holds_at_least,
+    any
+};
+
+struct script_condition {
+    script_condition_type type;
+    symbol subject;
+    std::vector<symbol> places;
+    std::vector<symbol> items;
+    int count;
+    std::vector<script_condition> alternatives;
+
+    script_condition() : type(script_condition_type::flag), count(0) {}
+};
+
+enum class script_effect_type {
+    say,
+    set_flag,
+    clear_flag,
+    move_item,
+    spawn_item,
+    give_item,
+    remove_items,
+    spawn_npc,
+    move_npc,
+    unlock,
+    prompt,
+    branch
+};
+
+struct script_effect {
+    script_effect_type type;
+    symbol subject;
+    symbol place;
+    std::string text;
+    std::string failure_text;
+    std::string name;
+    std::string description;
+    std::string kind;
+    item_properties properties;
+    std::vector<symbol> targets;
+    std::vector<std::pair<std::string, std::vector<script_effect>>> answers;
+    std::vector<script_condition> conditions;
+    std::vector<script_effect> then_effects;
+    std::vector<script_effect> else_effects;
+
+    script_effect() : type(script_effect_type::say) {}
+};
+
+struct script_rule {
+    symbol room;
+    std::vector<symbol> verbs;
+    bool always;
+    std::vector<std::string> objects;
+    std::vector<std::string> object_contains;
+    std::vector<script_condition> conditions;
+    std::vector<script_effect> effects;
+
+    script_rule() : always(false) {}
+};
+
+class script_engine {
+public:
+    using native_handler = std::function<bool(world&, room&, player&, std::string_view)>;
+
+private:
+    struct dispatch_target {
+        bool native;
+        size_t index;
+    };
+
+    std::vector<script_rule> rules;
+    std::vector<native_handler> natives;
+    std::vector<std::pair<uint64_t, size_t>> native_keys;
+    std::unordered_map<symbol, std::vector<size_t>> setup_rules;
+    std::unordered_map<uint64_t, std::vector<dispatch_target>> dispatch_table;
+
+    static uint64_t dispatch_key(symbol room, symbol verb);
+    static bool matches_object(const script_rule& rule, std::string_view object);
+    static bool check(const script_condition& condition, const world& game_world, const player& player);
+    static bool check_all(const std::vector<script_condition>& conditions, const world& game_world, const player& player);
+    static void apply(const script_effect& effect, world& game_world, player& player);
+    static void apply_all(const std::vector<script_effect>& effects, world& game_world, player& player);
+    static void collect_condition_flags(const std::vector<script_condition>& conditions, std::vector<symbol>& flags);
+    static void collect_effect_flags(const std::vector<script_effect>& effects, std::vector<symbol>& flags);
+
+public:
+    void add_rule(script_rule rule);
+    void add_native(const std::string& room_id, const std::string& verb, native_handler handler);
+    void add_builtin_natives();
+    void compile();
+    void collect_flags(std::vector<symbol>& flags) const;
+
+    void run_setup(world& game_world, room& current_room, player& player) const;
+    bool dispatch(world& game_world, room& current_room, player& player,
+        std::string_view verb, std::string_view object) const;
+
+    size_t get_rule_count() const;
+};
+
+#endif
@@ -0,0 +1,304 @@
+#include "game_server.hpp"
+#include "../batch/batch_runner.hpp"
+#include <iostream>
+#include <sstream>
+#include <cstring>
+#include <cstdio>
+
+#ifdef _WIN32
+#include <afunix.h>
+#pragma comment(lib, "Ws2_32.lib")
+using poll_entry = WSAPOLLFD;
+static const socket_handle invalid_socket = INVALID_SOCKET;
+static const int send_flags = 0;
+static int poll_sockets(poll_entry* entries, size_t count, int timeout) {
+    return WSAPoll(entries, static_cast<ULONG>(count), timeout);
+}
+static void close_socket(socket_handle s) {
+    closesocket(s);
+}
+static bool set_non_blocking(socket_handle s) {
+    u_long mode = 1;
+    return ioctlsocket(s, FIONBIO, &mode) == 0;
+}
+static bool would_block() {
+    return WSAGetLastError() == WSAEWOULDBLOCK;
+}
+#else
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <poll.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <cerrno>
+using poll_entry = pollfd;
+static const socket_handle invalid_socket = -1;
+#ifdef MSG_NOSIGNAL
+static const int send_flags = MSG_NOSIGNAL;
+#else
+static const int send_flags = 0;
+#endif
+static int poll_sockets(poll_entry* entries, size_t count, int timeout) {
+    return poll(entries, static_cast<nfds_t>(count), timeout);
+}
+static void close_socket(socket_handle s) {
+    close(s);
+}
+static bool set_non_blocking(socket_handle s) {
+    int flags = fcntl(s, F_GETFL, 0);
+    return flags != -1 && fcntl(s, F_SETFL, flags | O_NONBLOCK) == 0;
+}
+static bool would_block() {
+    return errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR;
+}
+#endif
+
+static const size_t max_line_length = 4096;
+static const size_t max_output_backlog = 1 << 20;
+
+game_server::game_server(const std::string& path, size_t session_limit) :
+    socket_path(path), listener(invalid_socket), listening(false),
+    server_running(false), max_sessions(session_limit) {}
+
+game_server::~game_server() {
+    for (auto& pair : sessions) {
+        close_socket(pair.first);
+    }
+    sessions.clear();
+
+    if (listening) {
+        close_socket(listener);
+        std::remove(socket_path.c_str());
+    }
+
+#ifdef _WIN32
+    WSACleanup();
+#endif
+}
+
+bool game_server::listen() {
+#ifdef _WIN32
+    WSADATA wsa_data;
+    if (WSAStartup(MAKEWORD(2, 2), &wsa_data) != 0) {
+        std::cerr << "Failed to initialize sockets." << std::endl;
+        return false;
+    }
+#endif
+
+    sockaddr_un address;
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (socket_path.size() >= sizeof(address.sun_path)) {
+        std::cerr << "Socket path is too long: " << socket_path << std::endl;
+        return false;
+    }
+    std::memcpy(address.sun_path, socket_path.c_str(), socket_path.size());
+
+    listener = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listener == invalid_socket) {
+        std::cerr << "Failed to create socket." << std::endl;
+        return false;
+    }
+
+    std::remove(socket_path.c_str());
+    if (bind(listener, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+        ::listen(listener, SOMAXCONN) != 0 ||
+        !set_non_blocking(listener)) {
+        std::cerr << "Failed to listen on " << socket_path << std::endl;
+        close_socket(listener);
+        listener = invalid_socket;
+        return false;
+    }
+
+    if (!world_template) {
+        world_template = game_engine::load_world_template();
+    }
+
+    listening = true;
+    return true;
+}
+
+void game_server::run() {
+    if (!listening && !listen()) {
+        return;
+    }
+
+    std::cerr << "Listening on " << socket_path << std::endl;
+
+    server_running = true;
+    std::vector<poll_entry> entries;
+    while (server_running) {
+        entries.clear();
+
+        poll_entry listen_entry{};
+        listen_entry.fd = listener;
+        listen_entry.events = POLLIN;
+        entries.push_back(listen_entry);
+
+        for (const auto& pair : sessions) {
+            poll_entry entry{};
+            entry.fd = pair.first;
+            entry.events = pair.second->closing ? 0 : POLLIN;
+            if (!pair.second->pending_output.empty()) {
+                entry.events |= POLLOUT;
+            }
+            entries.push_back(entry);
+        }
+
+        if (poll_sockets(entries.data(), entries.size(), -1) < 0) {
+            if (would_block()) {
+                continue;
+            }
+            std::cerr << "Polling failed." << std::endl;
+            break;
+        }
+
+        for (size_t i = 1; i < entries.size(); ++i) {
+            const auto& entry = entries[i];
+            if (entry.revents == 0) {
+                continue;
+            }
+
+            auto it = sessions.find(entry.fd);
+            if (it == sessions.end()) {
+                continue;
+            }
+
+            game_session& session = *it->second;
+            bool alive = true;
+
+            if (entry.revents & (POLLERR | POLLNVAL)) {
+                alive = false;
+            }
+            if (alive && (entry.revents & (POLLIN | POLLHUP))) {
+                alive = read_session(session);
+            }
+            if (alive && !session.pending_output.empty()) {
+                alive = write_session(session);
+            }
+            if (alive && session.closing && session.pending_output.empty()) {
+                alive = false;
+            }
+
+            if (!alive) {
+                close_session(entry.fd);
+            }
+        }
+
+        if (entries[0].revents & POLLIN) {
+            accept_sessions();
+        }
+    }
+
+    server_running = false;
+}
+
+void game_server::stop() {
+    server_running = false;
+}
+
+size_t game_server::get_session_count() const {
+    return sessions.size();
+}
+
+void game_server::accept_sessions() {
+    while (true) {
+        socket_handle connection = accept(listener, nullptr, nullptr);
+        if (connection == invalid_socket) {
+            return;
+        }
+
+        if (sessions.size() >= max_sessions || !set_non_blocking(connection)) {
+            const char message[] = "The Labyrinth is full. Try again later.\n";
+            send(connection, message, sizeof(message) - 1, send_flags);
+            close_socket(connection);
+            continue;
+        }
+
+        open_session(connection);
+    }
+}
+
+void game_server::open_session(socket_handle connection) {
+    auto session = std::make_unique<game_session>();
+    session->connection = connection;
+    session->engine = std::make_unique<game_engine>(world_template);
+
+    std::ostringstream output;
+    batch_runner(*session->engine).start(output);
+    session->pending_output = output.str();
+
+    write_session(*session);
+    sessions[connection] = std::move(session);
+}
+
+void game_server::close_session(socket_handle connection) {
+    auto it = sessions.find(connection);
+    if (it != sessions.end()) {
+        close_socket(connection);
+        sessions.erase(it);
+    }
+}
+
+bool game_server::read_session(game_session& session) {
+    char buffer[4096];
+    while (true) {
+        auto received = recv(session.connection, buffer, sizeof(buffer), 0);
+        if (received > 0) {
+            session.pending_input.append(buffer, static_cast<size_t>(received));
+            process_input(session);
+            if (session.pending_input.size() > max_line_length ||
+                session.pending_output.size() > max_output_backlog) {
+                return false;
+            }
+            continue;
+        }
+
+        if (received == 0) {
+            session.closing = true;
+            return true;
+        }
+
+        return would_block();
+    }
+}
+
+bool game_server::write_session(game_session& session) {
+    while (!session.pending_output.empty()) {
+        auto sent = send(session.connection, session.pending_output.data(),
+            static_cast<int>(session.pending_output.size()), send_flags);
+        if (sent > 0) {
+            session.pending_output.erase(0, static_cast<size_t>(sent));
+            continue;
+        }
+
+        return sent < 0 && would_block();
+    }
+
+    return true;
+}
+
+void game_server::process_input(game_session& session) {
+    if (session.closing) {
+        session.pending_input.clear();
+        return;
+    }
+
+    size_t last_newline = session.pending_input.rfind('\n');
+    if (last_newline == std::string::npos) {
+        return;
+    }
+
+    std::istringstream lines(session.pending_input.substr(0, last_newline + 1));
+    session.pending_input.erase(0, last_newline + 1);
+
+    std::ostringstream output;
+    batch_runner(*session.engine).run(lines, output);
+
+    session.pending_output += output.str();
+
+    if (!session.engine->is_running()) {
+        session.pending_output += "Farewell, wanderer.\n";
+        session.closing = true;
+    }
+}
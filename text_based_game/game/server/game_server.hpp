@@ -0,0 +1,56 @@
+#ifndef GAME_SERVER_HPP
+#define GAME_SERVER_HPP
+
+#include "../game_engine/game_engine.hpp"
+#include "../includes.hpp"
+#include <string>
+#include <vector>
+#include <memory>
+#include <unordered_map>
+
+#ifdef _WIN32
+#include <winsock2.h>
+using socket_handle = SOCKET;
+#else
+using socket_handle = int;
+#endif
+
+struct game_session {
+    socket_handle connection;
+    std::unique_ptr<game_engine> engine;
+    std::string pending_input;
+    std::string pending_output;
+    bool closing;
+
+    game_session() : connection(), closing(false) {}
+};
+
+class game_server {
+private:
+    std::string socket_path;
+    std::shared_ptr<const world> world_template;
+    socket_handle listener;
+    bool listening;
+    bool server_running;
+    size_t max_sessions;
+    std::unordered_map<socket_handle, std::unique_ptr<game_session>> sessions;
+
+    void accept_sessions();
+    void open_session(socket_handle connection);
+    void close_session(socket_handle connection);
+    bool read_session(game_session& session);
+    bool write_session(game_session& session);
+    void process_input(game_session& session);
+
+public:
+    game_server(const std::string& path, size_t session_limit = 4096);
+    ~game_server();
+
+    bool listen();
+    void run();
+    void stop();
+
+    size_t get_session_count() const;
+};
+
+#endif
@@ -0,0 +1,111 @@
+#include "binary_format.hpp"
+#include <fstream>
+#include <cstdio>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#endif
+
+string_pool::string_pool() {
+    add(std::string());
+}
+
+uint32_t string_pool::add(const std::string& text) {
+    auto result = indices.emplace(text, static_cast<uint32_t>(ordered.size()));
+    if (result.second) {
+        ordered.push_back(&result.first->first);
+    }
+    return result.first->second;
+}
+
+uint32_t string_pool::add(symbol name) {
+    return add(name.str());
+}
+
+uint32_t string_pool::add_list(const std::vector<std::string>& texts, std::vector<uint32_t>& lists) {
+    uint32_t first = static_cast<uint32_t>(lists.size());
+    for (const auto& text : texts) {
+        lists.push_back(add(text));
+    }
+    return first;
+}
+
+void string_pool::append_to(std::vector<char>& buffer, binary_section& entries, binary_section& data) const {
+    std::vector<string_entry> string_entries;
+    string_entries.reserve(ordered.size());
+    uint32_t offset = 0;
+    for (const std::string* text : ordered) {
+        string_entries.push_back({ offset, static_cast<uint32_t>(text->size()) });
+        offset += static_cast<uint32_t>(text->size());
+    }
+    entries = append_records(buffer, string_entries);
+
+    data = { static_cast<uint32_t>(buffer.size()), offset };
+    for (const std::string* text : ordered) {
+        buffer.insert(buffer.end(), text->begin(), text->end());
+    }
+}
+
+string_table_view::string_table_view() : entries(nullptr), data(nullptr), count(0) {}
+
+bool string_table_view::open(const mapped_file& file, const binary_section& entry_section, const binary_section& data_section) {
+    entries = section_records<string_entry>(file, entry_section);
+    data = section_records<char>(file, data_section);
+    if (!entries || !data || entry_section.count == 0) {
+        return false;
+    }
+
+    for (uint32_t i = 0; i < entry_section.count; ++i) {
+        if (entries[i].offset > data_section.count ||
+            entries[i].length > data_section.count - entries[i].offset) {
+            return false;
+        }
+    }
+
+    count = entry_section.count;
+    symbols.assign(count, symbol());
+    interned.assign(count, false);
+    return true;
+}
+
+bool string_table_view::contains(uint32_t index) const {
+    return index < count;
+}
+
+std::string_view string_table_view::text(uint32_t index) const {
+    return std::string_view(data + entries[index].offset, entries[index].length);
+}
+
+std::string string_table_view::str(uint32_t index) const {
+    return std::string(text(index));
+}
+
+symbol string_table_view::name(uint32_t index) {
+    if (!interned[index]) {
+        symbols[index] = symbol_table::intern(text(index));
+        interned[index] = true;
+    }
+    return symbols[index];
+}
+
+bool write_binary_file(const std::string& path, const std::vector<char>& buffer) {
+    std::string temp_path = path + ".tmp";
+    {
+        std::ofstream out_file(temp_path, std::ios::binary | std::ios::trunc);
+        if (!out_file) {
+            return false;
+        }
+        out_file.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        if (!out_file) {
+            return false;
+        }
+    }
+
+#ifdef _WIN32
+    return MoveFileExA(temp_path.c_str(), path.c_str(), MOVEFILE_REPLACE_EXISTING) != 0;
+#else
+    return std::rename(temp_path.c_str(), path.c_str()) == 0;
+#endif
+}
@@ -0,0 +1,79 @@
+#ifndef BINARY_FORMAT_HPP
+#define BINARY_FORMAT_HPP
+
+#include "mapped_file.hpp"
+#include "../symbol/symbol_table.hpp"
+#include "../includes.hpp"
+#include <string>
+#include <string_view>
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+
+struct binary_section {
+    uint32_t offset;
+    uint32_t count;
+};
+
+struct string_entry {
+    uint32_t offset;
+    uint32_t length;
+};
+
+class string_pool {
+private:
+    std::unordered_map<std::string, uint32_t> indices;
+    std::vector<const std::string*> ordered;
+
+public:
+    string_pool();
+
+    uint32_t add(const std::string& text);
+    uint32_t add(symbol name);
+    uint32_t add_list(const std::vector<std::string>& texts, std::vector<uint32_t>& lists);
+
+    // Appends the entry table followed by the character data; call it last so
+    // the fixed-size records before it stay aligned.
+    void append_to(std::vector<char>& buffer, binary_section& entries, binary_section& data) const;
+};
+
+class string_table_view {
+private:
+    const string_entry* entries;
+    const char* data;
+    uint32_t count;
+    std::vector<symbol> symbols;
+    std::vector<bool> interned;
+
+public:
+    string_table_view();
+
+    bool open(const mapped_file& file, const binary_section& entry_section, const binary_section& data_section);
+
+    bool contains(uint32_t index) const;
+    std::string_view text(uint32_t index) const;
+    std::string str(uint32_t index) const;
+    symbol name(uint32_t index);
+};
+
+bool write_binary_file(const std::string& path, const std::vector<char>& buffer);
+
+template <typename T>
+binary_section append_records(std::vector<char>& buffer, const std::vector<T>& records) {
+    binary_section section{ static_cast<uint32_t>(buffer.size()), static_cast<uint32_t>(records.size()) };
+    const char* first = reinterpret_cast<const char*>(records.data());
+    buffer.insert(buffer.end(), first, first + records.size() * sizeof(T));
+    return section;
+}
+
+template <typename T>
+const T* section_records(const mapped_file& file, const binary_section& section) {
+    if (section.offset % alignof(T) != 0 ||
+        section.offset > file.size() ||
+        section.count > (file.size() - section.offset) / sizeof(T)) {
+        return nullptr;
+    }
+    return reinterpret_cast<const T*>(file.data() + section.offset);
+}
+
+#endif
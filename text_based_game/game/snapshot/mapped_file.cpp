@@ -0,0 +1,113 @@
+#include "mapped_file.hpp"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#ifdef _WIN32
+mapped_file::mapped_file() :
+    bytes(nullptr), length(0), file_handle(INVALID_HANDLE_VALUE), mapping_handle(nullptr) {}
+#else
+mapped_file::mapped_file() : bytes(nullptr), length(0), descriptor(-1) {}
+#endif
+
+mapped_file::~mapped_file() {
+    close();
+}
+
+bool mapped_file::open(const std::string& path) {
+    close();
+
+#ifdef _WIN32
+    file_handle = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+        OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file_handle == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+
+    LARGE_INTEGER file_size;
+    if (!GetFileSizeEx(file_handle, &file_size) || file_size.QuadPart == 0) {
+        close();
+        return false;
+    }
+
+    mapping_handle = CreateFileMappingA(file_handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mapping_handle) {
+        close();
+        return false;
+    }
+
+    bytes = static_cast<const char*>(MapViewOfFile(mapping_handle, FILE_MAP_READ, 0, 0, 0));
+    if (!bytes) {
+        close();
+        return false;
+    }
+    length = static_cast<size_t>(file_size.QuadPart);
+#else
+    descriptor = ::open(path.c_str(), O_RDONLY);
+    if (descriptor < 0) {
+        return false;
+    }
+
+    struct stat file_info;
+    if (fstat(descriptor, &file_info) != 0 || file_info.st_size == 0) {
+        close();
+        return false;
+    }
+
+    void* view = mmap(nullptr, static_cast<size_t>(file_info.st_size), PROT_READ, MAP_PRIVATE, descriptor, 0);
+    if (view == MAP_FAILED) {
+        close();
+        return false;
+    }
+    bytes = static_cast<const char*>(view);
+    length = static_cast<size_t>(file_info.st_size);
+#endif
+
+    return true;
+}
+
+void mapped_file::close() {
+#ifdef _WIN32
+    if (bytes) {
+        UnmapViewOfFile(bytes);
+    }
+    if (mapping_handle) {
+        CloseHandle(mapping_handle);
+    }
+    if (file_handle != INVALID_HANDLE_VALUE) {
+        CloseHandle(file_handle);
+    }
+    mapping_handle = nullptr;
+    file_handle = INVALID_HANDLE_VALUE;
+#else
+    if (bytes) {
+        munmap(const_cast<char*>(bytes), length);
+    }
+    if (descriptor >= 0) {
+        ::close(descriptor);
+    }
+    descriptor = -1;
+#endif
+    bytes = nullptr;
+    length = 0;
+}
+
+bool mapped_file::is_open() const {
+    return bytes != nullptr;
+}
+
+const char* mapped_file::data() const {
+    return bytes;
+}
+
+size_t mapped_file::size() const {
+    return length;
+}
@@ -0,0 +1,34 @@
+#ifndef MAPPED_FILE_HPP
+#define MAPPED_FILE_HPP
+
+#include "../includes.hpp"
+#include <string>
+#include <cstddef>
+
+class mapped_file {
+private:
+    const char* bytes;
+    size_t length;
+#ifdef _WIN32
+    void* file_handle;
+    void* mapping_handle;
+#else
+    int descriptor;
+#endif
+
+    void close();
+
+public:
+    mapped_file();
+    ~mapped_file();
+    mapped_file(const mapped_file&) = delete;
+    mapped_file& operator=(const mapped_file&) = delete;
+
+    bool open(const std::string& path);
+    bool is_open() const;
+
+    const char* data() const;
+    size_t size() const;
+};
+
+#endif
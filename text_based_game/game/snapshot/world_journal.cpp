@@ -0,0 +1,435 @@
+#include "world_journal.hpp"
+#include "world_snapshot.hpp"
+#include "mapped_file.hpp"
+#include "../world/world.hpp"
+#include <cstring>
+#include <random>
+
+namespace {
+    const char journal_magic[8] = { 'L', 'O', 'E', 'J', 'R', 'N', 'L', '\0' };
+    const uint32_t journal_version = 1;
+    const size_t journal_header_size = sizeof(journal_magic) + 2 * sizeof(uint32_t);
+
+    enum journal_record : uint8_t {
+        record_string = 1,
+        record_flag,
+        record_item,
+        record_character_room,
+        record_npc_state,
+        record_room_visited,
+        record_connection,
+        record_puzzle_state,
+        record_puzzle_solved,
+        record_player,
+        record_inventory,
+        record_commit
+    };
+
+    size_t field_count(uint8_t kind) {
+        switch (kind) {
+        case record_flag:
+        case record_item:
+        case record_character_room:
+        case record_npc_state:
+        case record_room_visited:
+        case record_puzzle_solved:
+            return 2;
+        case record_puzzle_state:
+        case record_player:
+            return 3;
+        case record_connection:
+            return 4;
+        case record_commit:
+            return 1;
+        default:
+            return 0;
+        }
+    }
+
+    void append_u32(std::string& buffer, uint32_t value) {
+        buffer.append(reinterpret_cast<const char*>(&value), sizeof(value));
+    }
+
+    class journal_reader {
+    private:
+        const char* data;
+        size_t size;
+        size_t position;
+
+    public:
+        journal_reader(const char* bytes, size_t length, size_t start) :
+            data(bytes), size(length), position(start) {}
+
+        size_t offset() const {
+            return position;
+        }
+
+        bool read_u8(uint8_t& value) {
+            if (position + 1 > size) {
+                return false;
+            }
+            value = static_cast<uint8_t>(data[position++]);
+            return true;
+        }
+
+        bool read_u32(uint32_t& value) {
+            if (size - position < sizeof(value)) {
+                return false;
+            }
+            std::memcpy(&value, data + position, sizeof(value));
+            position += sizeof(value);
+            return true;
+        }
+
+        bool read_bytes(uint32_t length, std::string_view& value) {
+            if (size - position < length) {
+                return false;
+            }
+            value = std::string_view(data + position, length);
+            position += length;
+            return true;
+        }
+    };
+}
+
+world_journal::world_journal(size_t limit) :
+    generation(0), sequence(0), journal_size(0), compaction_limit(limit), needs_compaction(false),
+    player_health(0), player_inventory_size(0) {}
+
+world_journal::~world_journal() {
+    close();
+}
+
+std::string world_journal::journal_path_for(const std::string& path) {
+    return path + ".journal";
+}
+
+bool world_journal::open(const std::string& path, const world& game_world, const player& player) {
+    close();
+
+    snapshot_path = path;
+    journal_path = journal_path_for(path);
+    generation = std::random_device{}();
+    return compact(game_world, player);
+}
+
+void world_journal::close() {
+    if (journal_file.is_open()) {
+        journal_file.close();
+    }
+    pending.clear();
+    string_ids.clear();
+}
+
+bool world_journal::is_open() const {
+    return journal_file.is_open();
+}
+
+uint32_t world_journal::string_id(symbol name) {
+    auto it = string_ids.find(name);
+    if (it != string_ids.end()) {
+        return it->second;
+    }
+
+    uint32_t id = static_cast<uint32_t>(string_ids.size());
+    string_ids[name] = id;
+
+    const std::string& text = name.str();
+    pending += static_cast<char>(record_string);
+    append_u32(pending, id);
+    append_u32(pending, static_cast<uint32_t>(text.size()));
+    pending += text;
+    return id;
+}
+
+void world_journal::put_record(uint8_t kind, std::initializer_list<uint32_t> fields) {
+    pending += static_cast<char>(kind);
+    for (uint32_t field : fields) {
+        append_u32(pending, field);
+    }
+}
+
+void world_journal::flag_changed(symbol flag, bool value) {
+    put_record(record_flag, { string_id(flag), value ? 1u : 0u });
+}
+
+void world_journal::item_moved(symbol item_id, symbol location) {
+    put_record(record_item, { string_id(item_id), string_id(location) });
+}
+
+void world_journal::character_moved(symbol character_id, symbol room_id) {
+    put_record(record_character_room, { string_id(character_id), string_id(room_id) });
+}
+
+void world_journal::npc_state_changed(symbol npc_id, symbol state) {
+    put_record(record_npc_state, { string_id(npc_id), string_id(state) });
+}
+
+void world_journal::room_visited(symbol room_id, bool visited) {
+    put_record(record_room_visited, { string_id(room_id), visited ? 1u : 0u });
+}
+
+void world_journal::connection_changed(symbol room_id, symbol direction, const room_connection& connection) {
+    put_record(record_connection, { string_id(room_id), string_id(direction),
+        string_id(connection.room_id), string_id(connection.requires_) });
+}
+
+void world_journal::puzzle_state_changed(symbol room_id, symbol puzzle_id, uint32_t state) {
+    put_record(record_puzzle_state, { string_id(room_id), string_id(puzzle_id), state });
+}
+
+void world_journal::puzzle_solved(symbol room_id, symbol puzzle_id) {
+    put_record(record_puzzle_solved, { string_id(room_id), string_id(puzzle_id) });
+}
+
+void world_journal::structure_changed() {
+    needs_compaction = true;
+}
+
+void world_journal::capture_player(const player& player) {
+    player_room = player.get_current_room_symbol();
+    player_health = player.get_health();
+    player_inventory_size = player.get_inventory_size();
+    player_inventory.clear();
+    for (const auto& item_ptr : player.get_inventory()) {
+        player_inventory.push_back(item_ptr->get_id_symbol());
+    }
+}
+
+bool world_journal::commit(const world& game_world, const player& player) {
+    if (!is_open()) {
+        return false;
+    }
+
+    if (needs_compaction) {
+        return compact(game_world, player);
+    }
+
+    if (player.get_current_room_symbol() != player_room ||
+        player.get_health() != player_health ||
+        player.get_inventory_size() != player_inventory_size) {
+        put_record(record_player, { string_id(player.get_current_room_symbol()),
+            static_cast<uint32_t>(player.get_health()), static_cast<uint32_t>(player.get_inventory_size()) });
+    }
+
+    const auto& inventory = player.get_inventory();
+    bool inventory_changed = inventory.size() != player_inventory.size();
+    for (size_t i = 0; !inventory_changed && i < inventory.size(); ++i) {
+        inventory_changed = inventory[i]->get_id_symbol() != player_inventory[i];
+    }
+    if (inventory_changed) {
+        std::vector<uint32_t> ids;
+        for (const auto& item_ptr : inventory) {
+            ids.push_back(string_id(item_ptr->get_id_symbol()));
+        }
+        pending += static_cast<char>(record_inventory);
+        append_u32(pending, static_cast<uint32_t>(ids.size()));
+        for (uint32_t id : ids) {
+            append_u32(pending, id);
+        }
+    }
+
+    if (pending.empty()) {
+        return true;
+    }
+
+    put_record(record_commit, { ++sequence });
+    journal_file.write(pending.data(), static_cast<std::streamsize>(pending.size()));
+    journal_file.flush();
+    journal_size += pending.size();
+    pending.clear();
+    capture_player(player);
+
+    if (!journal_file) {
+        return false;
+    }
+
+    if (journal_size > compaction_limit) {
+        return compact(game_world, player);
+    }
+    return true;
+}
+
+bool world_journal::compact(const world& game_world, const player& player) {
+    ++generation;
+    if (!world_snapshot::save(snapshot_path, game_world, player, generation)) {
+        close();
+        return false;
+    }
+
+    if (journal_file.is_open()) {
+        journal_file.close();
+    }
+    journal_file.open(journal_path, std::ios::binary | std::ios::trunc);
+    if (!journal_file) {
+        return false;
+    }
+
+    journal_file.write(journal_magic, sizeof(journal_magic));
+    journal_file.write(reinterpret_cast<const char*>(&journal_version), sizeof(journal_version));
+    journal_file.write(reinterpret_cast<const char*>(&generation), sizeof(generation));
+    journal_file.flush();
+
+    pending.clear();
+    string_ids.clear();
+    sequence = 0;
+    journal_size = journal_header_size;
+    needs_compaction = false;
+    capture_player(player);
+    return static_cast<bool>(journal_file);
+}
+
+bool world_journal::replay(const std::string& path, uint32_t generation, world& game_world, player& player) {
+    mapped_file file;
+    if (!file.open(journal_path_for(path)) || file.size() < journal_header_size) {
+        return false;
+    }
+
+    uint32_t version = 0;
+    uint32_t journal_generation = 0;
+    std::memcpy(&version, file.data() + sizeof(journal_magic), sizeof(version));
+    std::memcpy(&journal_generation, file.data() + sizeof(journal_magic) + sizeof(version), sizeof(journal_generation));
+    if (std::memcmp(file.data(), journal_magic, sizeof(journal_magic)) != 0 ||
+        version != journal_version || journal_generation != generation) {
+        return false;
+    }
+
+    size_t committed = journal_header_size;
+    journal_reader scan(file.data(), file.size(), journal_header_size);
+    uint8_t kind = 0;
+    while (scan.read_u8(kind)) {
+        uint32_t value = 0;
+        bool complete = true;
+        if (kind == record_string) {
+            std::string_view text;
+            complete = scan.read_u32(value) && scan.read_u32(value) && scan.read_bytes(value, text);
+        }
+        else if (kind == record_inventory) {
+            uint32_t count = 0;
+            complete = scan.read_u32(count);
+            for (uint32_t i = 0; complete && i < count; ++i) {
+                complete = scan.read_u32(value);
+            }
+        }
+        else {
+            size_t fields = field_count(kind);
+            complete = fields > 0;
+            for (size_t i = 0; complete && i < fields; ++i) {
+                complete = scan.read_u32(value);
+            }
+        }
+
+        if (!complete) {
+            break;
+        }
+        if (kind == record_commit) {
+            committed = scan.offset();
+        }
+    }
+
+    std::vector<symbol> strings;
+    auto name = [&strings](uint32_t id) {
+        return id < strings.size() ? strings[id] : symbol();
+    };
+
+    journal_reader reader(file.data(), committed, journal_header_size);
+    while (reader.read_u8(kind)) {
+        uint32_t fields[4] = {};
+        if (kind == record_string) {
+            uint32_t id = 0;
+            uint32_t length = 0;
+            std::string_view text;
+            reader.read_u32(id);
+            reader.read_u32(length);
+            reader.read_bytes(length, text);
+            if (strings.size() <= id) {
+                strings.resize(id + 1);
+            }
+            strings[id] = symbol_table::intern(text);
+            continue;
+        }
+
+        if (kind == record_inventory) {
+            uint32_t count = 0;
+            reader.read_u32(count);
+            player.clear_inventory();
+            for (uint32_t i = 0; i < count; ++i) {
+                uint32_t id = 0;
+                reader.read_u32(id);
+                auto item_ptr = game_world.get_item(name(id));
+                if (item_ptr) {
+                    player.add_to_inventory(item_ptr);
+                }
+            }
+            continue;
+        }
+
+        for (size_t i = 0; i < field_count(kind); ++i) {
+            reader.read_u32(fields[i]);
+        }
+
+        switch (kind) {
+        case record_flag:
+            game_world.set_game_flag(name(fields[0]), fields[1] != 0);
+            break;
+        case record_item: {
+            auto item_ptr = game_world.get_item(name(fields[0]));
+            if (item_ptr) {
+                item_ptr->set_location(name(fields[1]));
+            }
+            break;
+        }
+        case record_character_room: {
+            auto npc_ptr = game_world.get_npc(name(fields[0]));
+            if (npc_ptr) {
+                npc_ptr->set_current_room(name(fields[1]));
+            }
+            break;
+        }
+        case record_npc_state: {
+            auto npc_ptr = game_world.get_npc(name(fields[0]));
+            if (npc_ptr) {
+                npc_ptr->set_state(name(fields[1]).str());
+            }
+            break;
+        }
+        case record_room_visited: {
+            auto room_ptr = game_world.get_room(name(fields[0]));
+            if (room_ptr) {
+                room_ptr->set_visited(fields[1] != 0);
+            }
+            break;
+        }
+        case record_connection: {
+            auto room_ptr = game_world.get_room(name(fields[0]));
+            if (room_ptr) {
+                room_ptr->add_connection(name(fields[1]), name(fields[2]), name(fields[3]));
+            }
+            break;
+        }
+        case record_puzzle_state: {
+            auto room_ptr = game_world.get_room(name(fields[0]));
+            if (room_ptr) {
+                room_ptr->set_puzzle_state(name(fields[1]), fields[2]);
+            }
+            break;
+        }
+        case record_puzzle_solved: {
+            auto room_ptr = game_world.get_room(name(fields[0]));
+            if (room_ptr) {
+                room_ptr->solve_puzzle(name(fields[1]).str());
+            }
+            break;
+        }
+        case record_player:
+            player.set_current_room(name(fields[0]));
+            player.set_health(static_cast<int>(fields[1]));
+            player.set_inventory_size(static_cast<int>(fields[2]));
+            break;
+        default:
+            break;
+        }
+    }
+
+    return true;
+}
@@ -0,0 +1,66 @@
+#ifndef WORLD_JOURNAL_HPP
+#define WORLD_JOURNAL_HPP
+
+#include "../symbol/symbol_table.hpp"
+#include "../includes.hpp"
+#include <string>
+#include <vector>
+#include <fstream>
+#include <unordered_map>
+#include <initializer_list>
+#include <cstdint>
+
+class world;
+class player;
+struct room_connection;
+
+class world_journal {
+private:
+    std::string snapshot_path;
+    std::string journal_path;
+    std::ofstream journal_file;
+    std::string pending;
+    std::unordered_map<symbol, uint32_t> string_ids;
+    uint32_t generation;
+    uint32_t sequence;
+    size_t journal_size;
+    size_t compaction_limit;
+    bool needs_compaction;
+
+    symbol player_room;
+    int player_health;
+    int player_inventory_size;
+    std::vector<symbol> player_inventory;
+
+    uint32_t string_id(symbol name);
+    void put_record(uint8_t kind, std::initializer_list<uint32_t> fields);
+    void capture_player(const player& player);
+    bool compact(const world& game_world, const player& player);
+
+public:
+    world_journal(size_t limit = 64 * 1024);
+    ~world_journal();
+    world_journal(const world_journal&) = delete;
+    world_journal& operator=(const world_journal&) = delete;
+
+    static std::string journal_path_for(const std::string& path);
+    static bool replay(const std::string& path, uint32_t generation, world& game_world, player& player);
+
+    bool open(const std::string& path, const world& game_world, const player& player);
+    void close();
+    bool is_open() const;
+
+    void flag_changed(symbol flag, bool value);
+    void item_moved(symbol item_id, symbol location);
+    void character_moved(symbol character_id, symbol room_id);
+    void npc_state_changed(symbol npc_id, symbol state);
+    void room_visited(symbol room_id, bool visited);
+    void connection_changed(symbol room_id, symbol direction, const room_connection& connection);
+    void puzzle_state_changed(symbol room_id, symbol puzzle_id, uint32_t state);
+    void puzzle_solved(symbol room_id, symbol puzzle_id);
+    void structure_changed();
+
+    bool commit(const world& game_world, const player& player);
+};
+
+#endif
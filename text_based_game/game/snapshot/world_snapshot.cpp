@@ -0,0 +1,363 @@
+#include "world_snapshot.hpp"
+#include "binary_format.hpp"
+#include <fstream>
+#include <iostream>
+#include <cstring>
+#include <vector>
+#include <unordered_set>
+
+namespace {
+    const char snapshot_magic[8] = { 'L', 'O', 'E', 'S', 'N', 'A', 'P', '\0' };
+    const uint32_t byte_order_mark = 0x01020304;
+
+    struct snapshot_header {
+        char magic[8];
+        uint32_t version;
+        uint32_t byte_order;
+        uint32_t file_size;
+        uint32_t generation;
+        uint32_t player_room;
+        int32_t player_health;
+        int32_t player_inventory_size;
+        binary_section strings;
+        binary_section string_data;
+        binary_section inventory;
+        binary_section flags;
+        binary_section items;
+        binary_section properties;
+        binary_section rooms;
+        binary_section connections;
+        binary_section puzzles;
+        binary_section npcs;
+    };
+
+    struct flag_record {
+        uint32_t name;
+        uint32_t value;
+    };
+
+    struct item_record {
+        uint32_t id;
+        uint32_t location;
+        uint32_t name;
+        uint32_t description;
+        uint32_t type;
+        uint32_t first_property;
+        uint32_t property_count;
+    };
+
+    struct property_record {
+        uint32_t key;
+        uint32_t kind;
+        uint32_t value;
+    };
+
+    struct room_record {
+        uint32_t id;
+        uint32_t visited;
+    };
+
+    struct connection_record {
+        uint32_t room;
+        uint32_t direction;
+        uint32_t target;
+        uint32_t requirement;
+    };
+
+    struct puzzle_record {
+        uint32_t room;
+        uint32_t puzzle;
+        uint32_t state;
+        uint32_t solved;
+    };
+
+    struct npc_record {
+        uint32_t id;
+        uint32_t room;
+        uint32_t state;
+        uint32_t name;
+        uint32_t description;
+        uint32_t role;
+    };
+}
+
+bool world_snapshot::is_snapshot(const std::string& path) {
+    std::ifstream in_file(path, std::ios::binary);
+    char magic[sizeof(snapshot_magic)] = {};
+    in_file.read(magic, sizeof(magic));
+    return in_file && std::memcmp(magic, snapshot_magic, sizeof(magic)) == 0;
+}
+
+bool world_snapshot::save(const std::string& path, const world& game_world, const player& player,
+    uint32_t generation) {
+    string_pool pool;
+
+    snapshot_header header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, snapshot_magic, sizeof(snapshot_magic));
+    header.version = version;
+    header.byte_order = byte_order_mark;
+    header.generation = generation;
+    header.player_room = pool.add(player.get_current_room_symbol());
+    header.player_health = player.get_health();
+    header.player_inventory_size = player.get_inventory_size();
+
+    std::vector<uint32_t> inventory;
+    for (const auto& item_ptr : player.get_inventory()) {
+        inventory.push_back(pool.add(item_ptr->get_id_symbol()));
+    }
+
+    std::vector<flag_record> flags;
+    for (const auto& pair : game_world.get_game_flags()) {
+        flags.push_back({ pool.add(pair.first), pair.second ? 1u : 0u });
+    }
+
+    std::vector<item_record> items;
+    std::vector<property_record> properties;
+    for (const item& current : game_world.get_items()) {
+        item_record record;
+        record.id = pool.add(current.get_id_symbol());
+        record.location = pool.add(current.get_location_symbol());
+        record.name = pool.add(current.get_name());
+        record.description = pool.add(current.get_description());
+        record.type = pool.add(current.get_type());
+        record.first_property = static_cast<uint32_t>(properties.size());
+        for (const auto& property : current.get_properties()) {
+            properties.push_back({ pool.add(property.first),
+                static_cast<uint32_t>(property.second.kind()), pool.add(property.second.to_string()) });
+        }
+        record.property_count = static_cast<uint32_t>(properties.size()) - record.first_property;
+        items.push_back(record);
+    }
+
+    std::vector<room_record> rooms;
+    std::vector<connection_record> connections;
+    std::vector<puzzle_record> puzzles;
+    for (const room& current : game_world.get_rooms()) {
+        uint32_t room_id = pool.add(current.get_id_symbol());
+        rooms.push_back({ room_id, current.visited() ? 1u : 0u });
+
+        for (const auto& connection : current.get_connections()) {
+            connections.push_back({ room_id, pool.add(connection.first),
+                pool.add(connection.second.room_id), pool.add(connection.second.requires_) });
+        }
+
+        for (const auto& state : current.get_puzzle_states()) {
+            puzzles.push_back({ room_id, pool.add(state.first), state.second, 0 });
+        }
+
+        for (const auto& room_puzzle : current.get_puzzles()) {
+            if (current.is_puzzle_solved(room_puzzle.id)) {
+                puzzles.push_back({ room_id, pool.add(room_puzzle.id), 0, 1 });
+            }
+        }
+    }
+
+    std::vector<npc_record> npcs;
+    for (const auto& npc_entry : game_world.get_npcs()) {
+        npc_record record;
+        record.id = pool.add(npc_entry.get_id_symbol());
+        record.room = pool.add(npc_entry.get_current_room_symbol());
+        record.state = pool.add(npc_entry.get_state());
+        record.name = pool.add(npc_entry.get_name());
+        record.description = pool.add(npc_entry.get_description());
+        record.role = pool.add(npc_entry.get_role());
+        npcs.push_back(record);
+    }
+
+    std::vector<char> buffer(sizeof(header));
+    header.inventory = append_records(buffer, inventory);
+    header.flags = append_records(buffer, flags);
+    header.items = append_records(buffer, items);
+    header.properties = append_records(buffer, properties);
+    header.rooms = append_records(buffer, rooms);
+    header.connections = append_records(buffer, connections);
+    header.puzzles = append_records(buffer, puzzles);
+    header.npcs = append_records(buffer, npcs);
+    pool.append_to(buffer, header.strings, header.string_data);
+    header.file_size = static_cast<uint32_t>(buffer.size());
+    std::memcpy(buffer.data(), &header, sizeof(header));
+
+    return write_binary_file(path, buffer);
+}
+
+bool world_snapshot::load(const std::string& path, world& game_world, player& player,
+    uint32_t* generation) {
+    mapped_file file;
+    if (!file.open(path) || file.size() < sizeof(snapshot_header)) {
+        return false;
+    }
+
+    const auto& header = *reinterpret_cast<const snapshot_header*>(file.data());
+    if (std::memcmp(header.magic, snapshot_magic, sizeof(snapshot_magic)) != 0 ||
+        header.version != version || header.byte_order != byte_order_mark ||
+        header.file_size != file.size()) {
+        std::cerr << "Unsupported snapshot: " << path << std::endl;
+        return false;
+    }
+
+    const auto* inventory = section_records<uint32_t>(file, header.inventory);
+    const auto* flags = section_records<flag_record>(file, header.flags);
+    const auto* items = section_records<item_record>(file, header.items);
+    const auto* properties = section_records<property_record>(file, header.properties);
+    const auto* rooms = section_records<room_record>(file, header.rooms);
+    const auto* connections = section_records<connection_record>(file, header.connections);
+    const auto* puzzles = section_records<puzzle_record>(file, header.puzzles);
+    const auto* npcs = section_records<npc_record>(file, header.npcs);
+    string_table_view strings;
+    if (!strings.open(file, header.strings, header.string_data) || !inventory || !flags ||
+        !items || !properties || !rooms || !connections || !puzzles || !npcs) {
+        std::cerr << "Corrupt snapshot: " << path << std::endl;
+        return false;
+    }
+
+    bool valid = strings.contains(header.player_room);
+    for (uint32_t i = 0; valid && i < header.inventory.count; ++i) {
+        valid = strings.contains(inventory[i]);
+    }
+    for (uint32_t i = 0; valid && i < header.flags.count; ++i) {
+        valid = strings.contains(flags[i].name);
+    }
+    for (uint32_t i = 0; valid && i < header.items.count; ++i) {
+        const auto& record = items[i];
+        valid = strings.contains(record.id) && strings.contains(record.location) &&
+            strings.contains(record.name) && strings.contains(record.description) &&
+            strings.contains(record.type) && record.first_property <= header.properties.count &&
+            record.property_count <= header.properties.count - record.first_property;
+    }
+    for (uint32_t i = 0; valid && i < header.properties.count; ++i) {
+        valid = strings.contains(properties[i].key) && strings.contains(properties[i].value) &&
+            properties[i].kind <= static_cast<uint32_t>(property_kind::list);
+    }
+    for (uint32_t i = 0; valid && i < header.rooms.count; ++i) {
+        valid = strings.contains(rooms[i].id);
+    }
+    for (uint32_t i = 0; valid && i < header.connections.count; ++i) {
+        const auto& record = connections[i];
+        valid = strings.contains(record.room) && strings.contains(record.direction) &&
+            strings.contains(record.target) && strings.contains(record.requirement);
+    }
+    for (uint32_t i = 0; valid && i < header.puzzles.count; ++i) {
+        valid = strings.contains(puzzles[i].room) && strings.contains(puzzles[i].puzzle);
+    }
+    for (uint32_t i = 0; valid && i < header.npcs.count; ++i) {
+        const auto& record = npcs[i];
+        valid = strings.contains(record.id) && strings.contains(record.room) &&
+            strings.contains(record.state) && strings.contains(record.name) &&
+            strings.contains(record.description) && strings.contains(record.role);
+    }
+    if (!valid) {
+        std::cerr << "Corrupt snapshot: " << path << std::endl;
+        return false;
+    }
+
+    game_world.clear_game_flags();
+    for (uint32_t i = 0; i < header.flags.count; ++i) {
+        game_world.set_game_flag(strings.name(flags[i].name), flags[i].value != 0);
+    }
+
+    for (uint32_t i = 0; i < header.items.count; ++i) {
+        const auto& record = items[i];
+        symbol item_id = strings.name(record.id);
+        if (game_world.get_item(item_id)) {
+            continue;
+        }
+
+        auto new_item = game_world.create_item(item_id);
+        new_item->set_name(strings.str(record.name));
+        new_item->set_description(strings.str(record.description));
+        new_item->set_type(strings.str(record.type));
+        for (uint32_t p = record.first_property; p < record.first_property + record.property_count; ++p) {
+            new_item->set_property(strings.name(properties[p].key), property_value::parse(
+                static_cast<property_kind>(properties[p].kind), strings.text(properties[p].value)));
+        }
+        game_world.add_item(new_item);
+    }
+
+    player.set_inventory_size(header.player_inventory_size);
+    player.clear_inventory();
+
+    std::unordered_set<symbol> saved_items;
+    for (uint32_t i = 0; i < header.items.count; ++i) {
+        saved_items.insert(strings.name(items[i].id));
+    }
+    std::vector<symbol> spawned_items;
+    for (const item& entry : game_world.get_items()) {
+        if (saved_items.count(entry.get_id_symbol()) == 0) {
+            spawned_items.push_back(entry.get_id_symbol());
+        }
+    }
+    for (symbol item_id : spawned_items) {
+        game_world.remove_item(item_id);
+    }
+
+    for (uint32_t i = 0; i < header.inventory.count; ++i) {
+        auto item_ptr = game_world.get_item(strings.name(inventory[i]));
+        if (item_ptr) {
+            player.add_to_inventory(item_ptr);
+        }
+    }
+
+    for (uint32_t i = 0; i < header.items.count; ++i) {
+        auto item_ptr = game_world.get_item(strings.name(items[i].id));
+        item_ptr->set_location(strings.name(items[i].location));
+    }
+
+    for (room& room_entry : game_world.get_rooms()) {
+        room_entry.clear_puzzle_states();
+    }
+
+    for (uint32_t i = 0; i < header.rooms.count; ++i) {
+        auto room_ptr = game_world.get_room(strings.name(rooms[i].id));
+        if (room_ptr) {
+            room_ptr->set_visited(rooms[i].visited != 0);
+        }
+    }
+
+    for (uint32_t i = 0; i < header.connections.count; ++i) {
+        const auto& record = connections[i];
+        auto room_ptr = game_world.get_room(strings.name(record.room));
+        if (room_ptr) {
+            room_ptr->add_connection(strings.name(record.direction),
+                strings.name(record.target), strings.name(record.requirement));
+        }
+    }
+
+    for (uint32_t i = 0; i < header.puzzles.count; ++i) {
+        const auto& record = puzzles[i];
+        auto room_ptr = game_world.get_room(strings.name(record.room));
+        if (!room_ptr) {
+            continue;
+        }
+
+        if (record.solved) {
+            room_ptr->solve_puzzle(strings.str(record.puzzle));
+        }
+        else {
+            room_ptr->set_puzzle_state(strings.name(record.puzzle), record.state);
+        }
+    }
+
+    for (uint32_t i = 0; i < header.npcs.count; ++i) {
+        const auto& record = npcs[i];
+        auto npc_ptr = game_world.get_npc(strings.name(record.id));
+        if (!npc_ptr) {
+            auto created = game_world.create_npc(strings.str(record.id));
+            npc_ptr = created.get();
+            npc_ptr->set_name(strings.str(record.name));
+            npc_ptr->set_description(strings.str(record.description));
+            npc_ptr->set_role(strings.str(record.role));
+            game_world.add_npc(created);
+        }
+        npc_ptr->set_current_room(strings.name(record.room));
+        npc_ptr->set_state(strings.str(record.state));
+    }
+
+    player.set_current_room(strings.name(header.player_room));
+    player.set_health(header.player_health);
+
+    if (generation) {
+        *generation = header.generation;
+    }
+    return true;
+}
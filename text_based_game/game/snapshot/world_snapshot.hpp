@@ -0,0 +1,21 @@
+#ifndef WORLD_SNAPSHOT_HPP
+#define WORLD_SNAPSHOT_HPP
+
+#include "../world/world.hpp"
+#include "../player/player.hpp"
+#include "../includes.hpp"
+#include <string>
+#include <cstdint>
+
+class world_snapshot {
+public:
+    static const uint32_t version = 2;
+
+    static bool is_snapshot(const std::string& path);
+    static bool save(const std::string& path, const world& game_world, const player& player,
+        uint32_t generation = 0);
+    static bool load(const std::string& path, world& game_world, player& player,
+        uint32_t* generation = nullptr);
+};
+
+#endif
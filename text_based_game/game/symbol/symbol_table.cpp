@@ -0,0 +1,196 @@
+#include "symbol_table.hpp"
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+    constexpr std::uint32_t chunk_bits = 12;
+    constexpr std::uint32_t chunk_size = 1u << chunk_bits;
+    constexpr std::uint32_t max_chunks = 1u << 14;
+    constexpr std::uint32_t initial_slots = 1024;
+
+    // Open-addressed name -> id table. Each slot packs the low 32 bits of
+    // the name's hash above the id, and zero marks an empty slot. Tables
+    // are only written under the storage lock and are replaced, not
+    // resized, when they fill, so readers can probe whichever table they
+    // loaded without locking.
+    struct id_table {
+        std::uint32_t mask;
+        std::unique_ptr<std::atomic<std::uint64_t>[]> slots;
+
+        explicit id_table(std::uint32_t capacity) :
+            mask(capacity - 1), slots(new std::atomic<std::uint64_t>[capacity]) {
+            for (std::uint32_t i = 0; i < capacity; ++i) {
+                slots[i].store(0, std::memory_order_relaxed);
+            }
+        }
+
+        void place(std::uint64_t hash, std::uint64_t entry) {
+            std::uint32_t i = static_cast<std::uint32_t>(hash) & mask;
+            while (slots[i].load(std::memory_order_relaxed) != 0) {
+                i = (i + 1) & mask;
+            }
+            slots[i].store(entry, std::memory_order_release);
+        }
+    };
+
+    struct symbol_storage {
+        std::array<std::atomic<std::string*>, max_chunks> chunks;
+        std::atomic<std::uint32_t> count;
+        std::atomic<id_table*> ids;
+        std::vector<std::unique_ptr<id_table>> tables;
+        std::mutex lock;
+
+        symbol_storage() : count(0) {
+            for (auto& chunk : chunks) {
+                chunk.store(nullptr, std::memory_order_relaxed);
+            }
+            tables.push_back(std::make_unique<id_table>(initial_slots));
+            ids.store(tables.back().get(), std::memory_order_release);
+            append("", 0);
+        }
+
+        ~symbol_storage() {
+            for (auto& chunk : chunks) {
+                delete[] chunk.load(std::memory_order_relaxed);
+            }
+        }
+
+        static std::uint64_t hash_of(std::string_view text) {
+            return std::hash<std::string_view>()(text);
+        }
+
+        static std::uint64_t pack(std::uint64_t hash, std::uint32_t id) {
+            return (hash << 32) | id;
+        }
+
+        // Returns 0 when the name is not interned; the empty name is id 0.
+        std::uint32_t find(std::string_view text, std::uint64_t hash) const {
+            const id_table* table = ids.load(std::memory_order_acquire);
+            std::uint32_t tag = static_cast<std::uint32_t>(hash);
+            std::uint32_t i = tag & table->mask;
+            while (true) {
+                std::uint64_t entry = table->slots[i].load(std::memory_order_acquire);
+                if (entry == 0) {
+                    return 0;
+                }
+
+                std::uint32_t id = static_cast<std::uint32_t>(entry);
+                if (static_cast<std::uint32_t>(entry >> 32) == tag && at(id) == text) {
+                    return id;
+                }
+                i = (i + 1) & table->mask;
+            }
+        }
+
+        void index(std::uint64_t hash, std::uint32_t id) {
+            id_table* table = ids.load(std::memory_order_relaxed);
+            std::uint32_t capacity = table->mask + 1;
+            if ((static_cast<std::uint64_t>(id) + 1) * 2 > capacity) {
+                auto grown = std::make_unique<id_table>(capacity * 2);
+                for (std::uint32_t i = 0; i < capacity; ++i) {
+                    std::uint64_t entry = table->slots[i].load(std::memory_order_relaxed);
+                    if (entry != 0) {
+                        grown->place(entry >> 32, entry);
+                    }
+                }
+                table = grown.get();
+                tables.push_back(std::move(grown));
+            }
+
+            table->place(hash, pack(hash, id));
+            ids.store(table, std::memory_order_release);
+        }
+
+        std::uint32_t append(std::string_view text, std::uint64_t hash) {
+            std::uint32_t id = count.load(std::memory_order_relaxed);
+            auto& chunk = chunks[id >> chunk_bits];
+            std::string* entries = chunk.load(std::memory_order_relaxed);
+            if (!entries) {
+                entries = new std::string[chunk_size];
+                chunk.store(entries, std::memory_order_release);
+            }
+
+            std::string& entry = entries[id & (chunk_size - 1)];
+            entry.assign(text.data(), text.size());
+            count.store(id + 1, std::memory_order_release);
+            if (id != 0) {
+                index(hash, id);
+            }
+            return id;
+        }
+
+        const std::string& at(std::uint32_t id) const {
+            return chunks[id >> chunk_bits].load(std::memory_order_acquire)[id & (chunk_size - 1)];
+        }
+    };
+
+    symbol_storage& storage() {
+        static symbol_storage instance;
+        return instance;
+    }
+}
+
+symbol::symbol(std::string_view text) : value(symbol_table::intern(text).index()) {}
+
+const std::string& symbol::str() const {
+    return symbol_table::name(*this);
+}
+
+std::ostream& operator<<(std::ostream& out, const symbol& s) {
+    return out << s.str();
+}
+
+symbol symbol_table::intern(std::string_view text) {
+    if (text.empty()) {
+        return symbol();
+    }
+
+    auto& table = storage();
+    std::uint64_t hash = symbol_storage::hash_of(text);
+    std::uint32_t id = table.find(text, hash);
+    if (id != 0) {
+        return symbol(id);
+    }
+
+    std::lock_guard<std::mutex> writer(table.lock);
+    id = table.find(text, hash);
+    if (id != 0) {
+        return symbol(id);
+    }
+
+    if (table.count.load(std::memory_order_relaxed) >= chunk_size * max_chunks) {
+        throw std::length_error("symbol table is full");
+    }
+    return symbol(table.append(text, hash));
+}
+
+bool symbol_table::lookup(std::string_view text, symbol& result) {
+    if (text.empty()) {
+        result = symbol();
+        return true;
+    }
+
+    auto& table = storage();
+    std::uint32_t id = table.find(text, symbol_storage::hash_of(text));
+    if (id == 0) {
+        return false;
+    }
+    result = symbol(id);
+    return true;
+}
+
+const std::string& symbol_table::name(symbol s) {
+    auto& table = storage();
+    if (s.index() >= table.count.load(std::memory_order_acquire)) {
+        return table.at(0);
+    }
+    return table.at(s.index());
+}
+
+size_t symbol_table::size() {
+    return storage().count.load(std::memory_order_acquire);
+}
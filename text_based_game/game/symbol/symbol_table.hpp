@@ -0,0 +1,48 @@
+#ifndef SYMBOL_TABLE_HPP
+#define SYMBOL_TABLE_HPP
+
+#include "../includes.hpp"
+#include <string>
+#include <string_view>
+#include <cstdint>
+#include <functional>
+#include <ostream>
+
+class symbol {
+private:
+    std::uint32_t value;
+
+public:
+    constexpr symbol() : value(0) {}
+    explicit constexpr symbol(std::uint32_t id) : value(id) {}
+    explicit symbol(std::string_view text);
+
+    constexpr std::uint32_t index() const { return value; }
+    constexpr bool empty() const { return value == 0; }
+    const std::string& str() const;
+
+    constexpr bool operator==(const symbol& other) const { return value == other.value; }
+    constexpr bool operator!=(const symbol& other) const { return value != other.value; }
+    constexpr bool operator<(const symbol& other) const { return value < other.value; }
+};
+
+namespace std {
+    template<>
+    struct hash<symbol> {
+        size_t operator()(const symbol& s) const noexcept {
+            return std::hash<std::uint32_t>()(s.index());
+        }
+    };
+}
+
+std::ostream& operator<<(std::ostream& out, const symbol& s);
+
+class symbol_table {
+public:
+    static symbol intern(std::string_view text);
+    static bool lookup(std::string_view text, symbol& result);
+    static const std::string& name(symbol s);
+    static size_t size();
+};
+
+#endif
@@ -0,0 +1,73 @@
+#include "thread_pool.hpp"
+
+thread_pool::thread_pool(size_t thread_count, size_t pending_limit) :
+    max_pending(pending_limit), running(0), stopping(false) {
+    if (thread_count == 0) {
+        thread_count = std::thread::hardware_concurrency();
+    }
+    if (thread_count == 0) {
+        thread_count = 1;
+    }
+    if (max_pending == 0) {
+        max_pending = thread_count * 4;
+    }
+
+    workers.reserve(thread_count);
+    for (size_t i = 0; i < thread_count; ++i) {
+        workers.emplace_back(&thread_pool::work, this);
+    }
+}
+
+thread_pool::~thread_pool() {
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        stopping = true;
+    }
+    task_ready.notify_all();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+void thread_pool::work() {
+    for (;;) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> guard(lock);
+            task_ready.wait(guard, [this] { return stopping || !tasks.empty(); });
+            if (tasks.empty()) {
+                return;
+            }
+            task = std::move(tasks.front());
+            tasks.pop_front();
+            ++running;
+        }
+        task_done.notify_all();
+
+        task();
+
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            --running;
+        }
+        task_done.notify_all();
+    }
+}
+
+void thread_pool::submit(std::function<void()> task) {
+    {
+        std::unique_lock<std::mutex> guard(lock);
+        task_done.wait(guard, [this] { return tasks.size() < max_pending; });
+        tasks.push_back(std::move(task));
+    }
+    task_ready.notify_one();
+}
+
+void thread_pool::wait() {
+    std::unique_lock<std::mutex> guard(lock);
+    task_done.wait(guard, [this] { return tasks.empty() && running == 0; });
+}
+
+size_t thread_pool::size() const {
+    return workers.size();
+}
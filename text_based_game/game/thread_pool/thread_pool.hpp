@@ -0,0 +1,36 @@
+#ifndef THREAD_POOL_HPP
+#define THREAD_POOL_HPP
+
+#include "../includes.hpp"
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <deque>
+#include <vector>
+
+class thread_pool {
+private:
+    std::vector<std::thread> workers;
+    std::deque<std::function<void()>> tasks;
+    std::mutex lock;
+    std::condition_variable task_ready;
+    std::condition_variable task_done;
+    size_t max_pending;
+    size_t running;
+    bool stopping;
+
+    void work();
+
+public:
+    explicit thread_pool(size_t thread_count = 0, size_t pending_limit = 0);
+    ~thread_pool();
+    thread_pool(const thread_pool&) = delete;
+    thread_pool& operator=(const thread_pool&) = delete;
+
+    void submit(std::function<void()> task);
+    void wait();
+    size_t size() const;
+};
+
+#endif
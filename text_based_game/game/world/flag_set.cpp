@@ -0,0 +1,108 @@
+#include "flag_set.hpp"
+#include <algorithm>
+
+flag_set::flag_set() : shape(std::make_shared<layout>()) {}
+
+std::uint32_t flag_set::slot_of(symbol flag) const {
+    std::uint32_t index = flag.index();
+    return index < shape->slots.size() ? shape->slots[index] : 0;
+}
+
+bool flag_set::test(const std::vector<std::uint64_t>& bits, std::uint32_t slot) const {
+    return (bits[slot >> 6] >> (slot & 63)) & 1;
+}
+
+void flag_set::assign(std::vector<std::uint64_t>& bits, std::uint32_t slot, bool value) {
+    std::uint64_t mask = std::uint64_t(1) << (slot & 63);
+    if (value) {
+        bits[slot >> 6] |= mask;
+    }
+    else {
+        bits[slot >> 6] &= ~mask;
+    }
+}
+
+void flag_set::declare(symbol flag) {
+    if (flag.empty() || is_declared(flag)) {
+        return;
+    }
+
+    if (shape.use_count() > 1) {
+        shape = std::make_shared<layout>(*shape);
+    }
+
+    if (flag.index() >= shape->slots.size()) {
+        shape->slots.resize(flag.index() + 1, 0);
+    }
+    shape->names.push_back(flag);
+    std::uint32_t slot = static_cast<std::uint32_t>(shape->names.size() - 1);
+    shape->slots[flag.index()] = slot + 1;
+
+    if ((slot >> 6) >= values.size()) {
+        values.push_back(0);
+        assigned.push_back(0);
+    }
+
+    auto it = dynamic.find(flag);
+    if (it != dynamic.end()) {
+        assign(values, slot, it->second);
+        assign(assigned, slot, true);
+        dynamic.erase(it);
+    }
+}
+
+bool flag_set::is_declared(symbol flag) const {
+    return slot_of(flag) != 0;
+}
+
+bool flag_set::get(symbol flag) const {
+    std::uint32_t slot = slot_of(flag);
+    if (slot != 0) {
+        return test(values, slot - 1);
+    }
+
+    auto it = dynamic.find(flag);
+    return it != dynamic.end() && it->second;
+}
+
+bool flag_set::set(symbol flag, bool value) {
+    std::uint32_t slot = slot_of(flag);
+    if (slot == 0) {
+        auto result = dynamic.emplace(flag, value);
+        if (result.second) {
+            return true;
+        }
+        if (result.first->second == value) {
+            return false;
+        }
+        result.first->second = value;
+        return true;
+    }
+
+    --slot;
+    if (test(assigned, slot) && test(values, slot) == value) {
+        return false;
+    }
+    assign(assigned, slot, true);
+    assign(values, slot, value);
+    return true;
+}
+
+void flag_set::clear() {
+    std::fill(values.begin(), values.end(), 0);
+    std::fill(assigned.begin(), assigned.end(), 0);
+    dynamic.clear();
+}
+
+std::vector<std::pair<symbol, bool>> flag_set::entries() const {
+    std::vector<std::pair<symbol, bool>> result;
+    for (std::uint32_t slot = 0; slot < shape->names.size(); ++slot) {
+        if (test(assigned, slot)) {
+            result.emplace_back(shape->names[slot], test(values, slot));
+        }
+    }
+    for (const auto& pair : dynamic) {
+        result.emplace_back(pair.first, pair.second);
+    }
+    return result;
+}
@@ -0,0 +1,45 @@
+#ifndef FLAG_SET_HPP
+#define FLAG_SET_HPP
+
+#include "../symbol/symbol_table.hpp"
+#include "../includes.hpp"
+#include <vector>
+#include <memory>
+#include <utility>
+#include <cstdint>
+#include <unordered_map>
+
+// Game flags as a dense bitset. Flags declared while loading get a slot
+// found by indexing with the flag's symbol, and the slot layout is shared
+// by every instance of a world. Flags first seen at runtime live in a side
+// table instead.
+class flag_set {
+private:
+    struct layout {
+        std::vector<std::uint32_t> slots;
+        std::vector<symbol> names;
+    };
+
+    std::shared_ptr<layout> shape;
+    std::vector<std::uint64_t> values;
+    std::vector<std::uint64_t> assigned;
+    std::unordered_map<symbol, bool> dynamic;
+
+    std::uint32_t slot_of(symbol flag) const;
+    bool test(const std::vector<std::uint64_t>& bits, std::uint32_t slot) const;
+    void assign(std::vector<std::uint64_t>& bits, std::uint32_t slot, bool value);
+
+public:
+    flag_set();
+
+    void declare(symbol flag);
+    bool is_declared(symbol flag) const;
+
+    bool get(symbol flag) const;
+    bool set(symbol flag, bool value);
+    void clear();
+
+    std::vector<std::pair<symbol, bool>> entries() const;
+};
+
+#endif
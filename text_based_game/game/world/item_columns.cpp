@@ -0,0 +1,115 @@
+#include "item_columns.hpp"
+#include "../item/item.hpp"
+
+std::uint32_t item_columns::flag_bit(symbol property, bool assign) {
+    auto it = flag_bits.find(property);
+    if (it != flag_bits.end()) {
+        return it->second;
+    }
+
+    if (!assign || flag_bits.size() >= 32) {
+        return 0;
+    }
+
+    std::uint32_t bit = 1u << flag_bits.size();
+    flag_bits.emplace(property, bit);
+    return bit;
+}
+
+void item_columns::select_equal(const std::vector<symbol>& column, symbol value, std::vector<std::uint32_t>& rows) const {
+    const symbol* data = column.data();
+    const symbol* live = ids.data();
+    std::uint32_t count = static_cast<std::uint32_t>(column.size());
+    for (std::uint32_t row = 0; row < count; ++row) {
+        if (data[row] == value && !live[row].empty()) {
+            rows.push_back(row);
+        }
+    }
+}
+
+void item_columns::assign(std::uint32_t row, const item& entry) {
+    if (row >= ids.size()) {
+        ids.resize(row + 1);
+        locations.resize(row + 1);
+        types.resize(row + 1);
+        names.resize(row + 1);
+        flags.resize(row + 1);
+    }
+
+    ids[row] = entry.get_id_symbol();
+    locations[row] = entry.get_location_symbol();
+    types[row] = symbol_table::intern(entry.get_type());
+    names[row] = symbol_table::intern(entry.get_name());
+    flags[row] = 0;
+    for (const auto& property : entry.get_properties()) {
+        if (property.second.as_bool()) {
+            flags[row] |= flag_bit(property.first, true);
+        }
+    }
+}
+
+void item_columns::clear(std::uint32_t row) {
+    if (row < ids.size()) {
+        ids[row] = symbol();
+        locations[row] = symbol();
+        types[row] = symbol();
+        names[row] = symbol();
+        flags[row] = 0;
+    }
+}
+
+void item_columns::set_location(std::uint32_t row, symbol location) {
+    locations[row] = location;
+}
+
+void item_columns::set_type(std::uint32_t row, symbol type) {
+    types[row] = type;
+}
+
+void item_columns::set_name(std::uint32_t row, symbol name) {
+    names[row] = name;
+}
+
+void item_columns::set_flag(std::uint32_t row, symbol property, bool value) {
+    std::uint32_t bit = flag_bit(property, value);
+    if (value) {
+        flags[row] |= bit;
+    }
+    else {
+        flags[row] &= ~bit;
+    }
+}
+
+void item_columns::select_location(symbol location, std::vector<std::uint32_t>& rows) const {
+    select_equal(locations, location, rows);
+}
+
+void item_columns::select_type(symbol type, std::vector<std::uint32_t>& rows) const {
+    select_equal(types, type, rows);
+}
+
+void item_columns::select_name(symbol name, std::vector<std::uint32_t>& rows) const {
+    select_equal(names, name, rows);
+}
+
+bool item_columns::select_flag(const std::string& property, std::vector<std::uint32_t>& rows) const {
+    symbol property_symbol;
+    if (!symbol_table::lookup(property, property_symbol)) {
+        return true;
+    }
+
+    auto it = flag_bits.find(property_symbol);
+    if (it == flag_bits.end()) {
+        return flag_bits.size() < 32;
+    }
+
+    std::uint32_t bit = it->second;
+    const std::uint32_t* data = flags.data();
+    std::uint32_t count = static_cast<std::uint32_t>(flags.size());
+    for (std::uint32_t row = 0; row < count; ++row) {
+        if (data[row] & bit) {
+            rows.push_back(row);
+        }
+    }
+    return true;
+}
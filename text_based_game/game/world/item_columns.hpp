@@ -0,0 +1,44 @@
+#ifndef ITEM_COLUMNS_HPP
+#define ITEM_COLUMNS_HPP
+
+#include "../symbol/symbol_table.hpp"
+#include "../includes.hpp"
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <unordered_map>
+
+class item;
+
+// Column copy of the fields bulk item queries filter on. Row numbers are the
+// item's slot index in the world, and vacant rows have an empty id. Each
+// boolean property gets a bit in the flags column the first time it is
+// set, up to 32 distinct properties.
+class item_columns {
+private:
+    std::vector<symbol> ids;
+    std::vector<symbol> locations;
+    std::vector<symbol> types;
+    std::vector<symbol> names;
+    std::vector<std::uint32_t> flags;
+    std::unordered_map<symbol, std::uint32_t> flag_bits;
+
+    std::uint32_t flag_bit(symbol property, bool assign);
+    void select_equal(const std::vector<symbol>& column, symbol value, std::vector<std::uint32_t>& rows) const;
+
+public:
+    void assign(std::uint32_t row, const item& entry);
+    void clear(std::uint32_t row);
+
+    void set_location(std::uint32_t row, symbol location);
+    void set_type(std::uint32_t row, symbol type);
+    void set_name(std::uint32_t row, symbol name);
+    void set_flag(std::uint32_t row, symbol property, bool value);
+
+    void select_location(symbol location, std::vector<std::uint32_t>& rows) const;
+    void select_type(symbol type, std::vector<std::uint32_t>& rows) const;
+    void select_name(symbol name, std::vector<std::uint32_t>& rows) const;
+    bool select_flag(const std::string& property, std::vector<std::uint32_t>& rows) const;
+};
+
+#endif
@@ -0,0 +1,70 @@
+#include "location_index.hpp"
+#include "../item/item.hpp"
+#include "../snapshot/world_journal.hpp"
+#include <algorithm>
+
+location_index::location_index() : journal(nullptr) {}
+
+void location_index::erase_from(std::vector<item*>& bucket, const item* entry) {
+    auto it = std::find(bucket.begin(), bucket.end(), entry);
+
+    if (it != bucket.end()) {
+        bucket.erase(it);
+    }
+}
+
+void location_index::insert(item* entry) {
+    buckets[entry->get_location_symbol()].push_back(entry);
+    entry->set_location_index(this);
+}
+
+void location_index::remove(const item* entry) {
+    auto it = buckets.find(entry->get_location_symbol());
+    if (it != buckets.end()) {
+        erase_from(it->second, entry);
+    }
+}
+
+void location_index::relocate(const item* entry, symbol from, symbol to) {
+    if (from == to) {
+        return;
+    }
+
+    auto from_it = buckets.find(from);
+    if (from_it == buckets.end()) {
+        return;
+    }
+
+    auto& from_bucket = from_it->second;
+    auto it = std::find(from_bucket.begin(), from_bucket.end(), entry);
+    if (it == from_bucket.end()) {
+        return;
+    }
+
+    item* moved = *it;
+    from_bucket.erase(it);
+    buckets[to].push_back(moved);
+
+    if (journal) {
+        journal->item_moved(entry->get_id_symbol(), to);
+    }
+}
+
+const std::vector<item*>& location_index::items_at(symbol location) const {
+    static const std::vector<item*> empty_bucket;
+
+    auto it = buckets.find(location);
+    if (it != buckets.end()) {
+        return it->second;
+    }
+    return empty_bucket;
+}
+
+size_t location_index::count_at(symbol location) const {
+    auto it = buckets.find(location);
+    return it != buckets.end() ? it->second.size() : 0;
+}
+
+void location_index::set_journal(world_journal* owner) {
+    journal = owner;
+}
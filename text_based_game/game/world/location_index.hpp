@@ -0,0 +1,33 @@
+#ifndef LOCATION_INDEX_HPP
+#define LOCATION_INDEX_HPP
+
+#include "../symbol/symbol_table.hpp"
+#include "../includes.hpp"
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+class item;
+class world_journal;
+
+class location_index {
+private:
+    std::unordered_map<symbol, std::vector<item*>> buckets;
+    world_journal* journal;
+
+    static void erase_from(std::vector<item*>& bucket, const item* entry);
+
+public:
+    location_index();
+
+    void insert(item* entry);
+    void remove(const item* entry);
+    void relocate(const item* entry, symbol from, symbol to);
+
+    const std::vector<item*>& items_at(symbol location) const;
+    size_t count_at(symbol location) const;
+
+    void set_journal(world_journal* owner);
+};
+
+#endif
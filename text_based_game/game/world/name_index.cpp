@@ -0,0 +1,224 @@
+#include "name_index.hpp"
+#include <algorithm>
+#include <cctype>
+
+namespace {
+    int compare_folded(std::string_view text, std::string_view query) {
+        size_t length = std::min(text.size(), query.size());
+        for (size_t i = 0; i < length; ++i) {
+            unsigned char a = static_cast<unsigned char>(text[i]);
+            unsigned char b = static_cast<unsigned char>(name_index::fold(query[i]));
+            if (a != b) {
+                return a < b ? -1 : 1;
+            }
+        }
+        if (text.size() < query.size()) {
+            return -1;
+        }
+        return 0;
+    }
+}
+
+name_index::name_index() : live_count(0), dirty(false) {}
+
+char name_index::fold(char c) {
+    if (c == '_') {
+        return ' ';
+    }
+    return static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+}
+
+void name_index::add(std::string_view name, symbol target) {
+    if (name.empty()) {
+        return;
+    }
+
+    name_entry new_entry;
+    new_entry.key.reserve(name.size());
+    for (char c : name) {
+        new_entry.key.push_back(fold(c));
+    }
+    new_entry.target = target;
+
+    auto& slots = target_entries[target];
+    for (std::uint32_t slot : slots) {
+        if (entries[slot].key == new_entry.key) {
+            return;
+        }
+    }
+
+    slots.push_back(static_cast<std::uint32_t>(entries.size()));
+    entries.push_back(std::move(new_entry));
+    ++live_count;
+    dirty = true;
+}
+
+void name_index::remove(symbol target) {
+    auto it = target_entries.find(target);
+    if (it == target_entries.end()) {
+        return;
+    }
+
+    for (std::uint32_t slot : it->second) {
+        entries[slot].target = symbol();
+        --live_count;
+    }
+    target_entries.erase(it);
+    dirty = true;
+}
+
+bool name_index::empty() const {
+    return live_count == 0;
+}
+
+std::string_view name_index::suffix_text(const suffix_entry& suffix) const {
+    return std::string_view(entries[suffix.entry].key).substr(suffix.offset);
+}
+
+bool name_index::is_built() const {
+    return !dirty;
+}
+
+void name_index::build() {
+    if (!dirty) {
+        return;
+    }
+
+    if (live_count != entries.size()) {
+        entries.erase(std::remove_if(entries.begin(), entries.end(),
+            [](const name_entry& entry) { return entry.target.empty(); }), entries.end());
+
+        target_entries.clear();
+        for (std::uint32_t i = 0; i < entries.size(); ++i) {
+            target_entries[entries[i].target].push_back(i);
+        }
+    }
+
+    sorted_entries.clear();
+    suffixes.clear();
+
+    for (std::uint32_t i = 0; i < entries.size(); ++i) {
+        sorted_entries.push_back(i);
+        for (std::uint32_t offset = 0; offset < entries[i].key.size(); ++offset) {
+            suffixes.push_back({ i, offset });
+        }
+    }
+
+    std::stable_sort(sorted_entries.begin(), sorted_entries.end(),
+        [this](std::uint32_t a, std::uint32_t b) { return entries[a].key < entries[b].key; });
+
+    std::stable_sort(suffixes.begin(), suffixes.end(),
+        [this](const suffix_entry& a, const suffix_entry& b) { return suffix_text(a) < suffix_text(b); });
+
+    dirty = false;
+}
+
+symbol name_index::shortest_match(std::vector<std::uint32_t>::const_iterator first,
+    std::vector<std::uint32_t>::const_iterator last) const {
+    const name_entry* best = nullptr;
+    std::uint32_t best_index = 0;
+    for (; first != last; ++first) {
+        const name_entry& candidate = entries[*first];
+        if (!best || candidate.key.size() < best->key.size() ||
+            (candidate.key.size() == best->key.size() && *first < best_index)) {
+            best = &candidate;
+            best_index = *first;
+        }
+    }
+    return best ? best->target : symbol();
+}
+
+symbol name_index::scan(std::string_view query, bool prefix_only) const {
+    std::string folded;
+    folded.reserve(query.size());
+    for (char c : query) {
+        folded.push_back(fold(c));
+    }
+
+    const name_entry* best = nullptr;
+    for (const auto& candidate : entries) {
+        if (candidate.target.empty()) {
+            continue;
+        }
+        size_t pos = candidate.key.find(folded);
+        if (pos == std::string::npos || (prefix_only && pos != 0)) {
+            continue;
+        }
+        if (!best || candidate.key.size() < best->key.size()) {
+            best = &candidate;
+        }
+    }
+    return best ? best->target : symbol();
+}
+
+symbol name_index::find_exact(std::string_view query) const {
+    if (dirty) {
+        for (const auto& candidate : entries) {
+            if (!candidate.target.empty() && candidate.key.size() == query.size() &&
+                compare_folded(candidate.key, query) == 0) {
+                return candidate.target;
+            }
+        }
+        return symbol();
+    }
+
+    auto it = std::lower_bound(sorted_entries.begin(), sorted_entries.end(), query,
+        [this](std::uint32_t entry, std::string_view q) { return compare_folded(entries[entry].key, q) < 0; });
+
+    if (it != sorted_entries.end()) {
+        const std::string& key = entries[*it].key;
+        if (key.size() == query.size() && compare_folded(key, query) == 0) {
+            return entries[*it].target;
+        }
+    }
+    return symbol();
+}
+
+symbol name_index::find_prefix(std::string_view query) const {
+    if (dirty) {
+        return scan(query, true);
+    }
+
+    auto first = std::lower_bound(sorted_entries.cbegin(), sorted_entries.cend(), query,
+        [this](std::uint32_t entry, std::string_view q) { return compare_folded(entries[entry].key, q) < 0; });
+    auto last = std::upper_bound(first, sorted_entries.cend(), query,
+        [this](std::string_view q, std::uint32_t entry) { return compare_folded(entries[entry].key, q) > 0; });
+
+    return shortest_match(first, last);
+}
+
+symbol name_index::find_substring(std::string_view query) const {
+    if (dirty) {
+        return scan(query, false);
+    }
+
+    auto first = std::lower_bound(suffixes.begin(), suffixes.end(), query,
+        [this](const suffix_entry& suffix, std::string_view q) { return compare_folded(suffix_text(suffix), q) < 0; });
+
+    const name_entry* best = nullptr;
+    std::uint32_t best_index = 0;
+    for (auto it = first; it != suffixes.end() && compare_folded(suffix_text(*it), query) == 0; ++it) {
+        const name_entry& candidate = entries[it->entry];
+        if (!best || candidate.key.size() < best->key.size() ||
+            (candidate.key.size() == best->key.size() && it->entry < best_index)) {
+            best = &candidate;
+            best_index = it->entry;
+        }
+    }
+    return best ? best->target : symbol();
+}
+
+symbol name_index::find(std::string_view query) const {
+    if (query.empty()) {
+        return symbol();
+    }
+
+    symbol result = find_exact(query);
+    if (result.empty()) {
+        result = find_prefix(query);
+    }
+    if (result.empty()) {
+        result = find_substring(query);
+    }
+    return result;
+}
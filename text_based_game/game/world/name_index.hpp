@@ -0,0 +1,58 @@
+#ifndef NAME_INDEX_HPP
+#define NAME_INDEX_HPP
+
+#include "../symbol/symbol_table.hpp"
+#include "../includes.hpp"
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstdint>
+#include <unordered_map>
+
+class name_index {
+private:
+    struct name_entry {
+        std::string key;
+        symbol target;
+    };
+
+    struct suffix_entry {
+        std::uint32_t entry;
+        std::uint32_t offset;
+    };
+
+    // Removed entries keep their slot with an empty target until the next
+    // build() compacts them away; target_entries finds a target's slots.
+    std::vector<name_entry> entries;
+    std::unordered_map<symbol, std::vector<std::uint32_t>> target_entries;
+    size_t live_count;
+    std::vector<std::uint32_t> sorted_entries;
+    std::vector<suffix_entry> suffixes;
+    bool dirty;
+
+    std::string_view suffix_text(const suffix_entry& suffix) const;
+    symbol shortest_match(std::vector<std::uint32_t>::const_iterator first,
+        std::vector<std::uint32_t>::const_iterator last) const;
+    symbol scan(std::string_view query, bool prefix_only) const;
+
+public:
+    name_index();
+
+    static char fold(char c);
+
+    void add(std::string_view name, symbol target);
+    void remove(symbol target);
+    bool empty() const;
+
+    // Lookups never modify the index, so a built index can be shared between
+    // threads. Until build() runs after a change they fall back to a scan.
+    void build();
+    bool is_built() const;
+
+    symbol find_exact(std::string_view query) const;
+    symbol find_prefix(std::string_view query) const;
+    symbol find_substring(std::string_view query) const;
+    symbol find(std::string_view query) const;
+};
+
+#endif
@@ -0,0 +1,172 @@
+#include "nav_graph.hpp"
+#include <algorithm>
+#include <deque>
+
+nav_graph::nav_graph() : valid(false) {}
+
+uint32_t nav_graph::add_node(symbol room_id) {
+    auto result = node_index.emplace(room_id, static_cast<uint32_t>(nodes.size()));
+    if (result.second) {
+        nodes.push_back(room_id);
+    }
+    return result.first->second;
+}
+
+void nav_graph::add_edge(symbol from, symbol direction, symbol to, symbol requires_) {
+    pending.push_back({ from, direction, to, requires_ });
+}
+
+void nav_graph::finalize() {
+    nodes.clear();
+    node_index.clear();
+    edges.clear();
+
+    // Exits within a room are ordered by direction name so searches break
+    // ties the same way on every build.
+    std::sort(pending.begin(), pending.end(), [](const pending_edge& left, const pending_edge& right) {
+        if (left.from != right.from) {
+            return left.from < right.from;
+        }
+        return left.direction.str() < right.direction.str();
+    });
+
+    for (const auto& entry : pending) {
+        add_node(entry.from);
+    }
+    for (const auto& entry : pending) {
+        add_node(entry.to);
+    }
+
+    offsets.assign(nodes.size() + 1, 0);
+    for (const auto& entry : pending) {
+        ++offsets[node_index[entry.from] + 1];
+    }
+    for (size_t i = 1; i < offsets.size(); ++i) {
+        offsets[i] += offsets[i - 1];
+    }
+
+    edges.resize(pending.size());
+    for (size_t i = 0; i < pending.size(); ++i) {
+        const auto& entry = pending[i];
+        edges[i] = { node_index[entry.to], entry.direction, entry.requires_ };
+    }
+
+    pending.clear();
+    pending.shrink_to_fit();
+    valid = true;
+}
+
+void nav_graph::invalidate() {
+    valid = false;
+}
+
+bool nav_graph::is_valid() const {
+    return valid;
+}
+
+uint32_t nav_graph::node(symbol room_id) const {
+    auto it = node_index.find(room_id);
+    return it != node_index.end() ? it->second : no_node;
+}
+
+symbol nav_graph::room_at(uint32_t node_id) const {
+    return node_id < nodes.size() ? nodes[node_id] : symbol();
+}
+
+size_t nav_graph::node_count() const {
+    return nodes.size();
+}
+
+size_t nav_graph::edge_count() const {
+    return edges.size();
+}
+
+const nav_graph::edge* nav_graph::exits_begin(uint32_t node_id) const {
+    return edges.data() + offsets[node_id];
+}
+
+const nav_graph::edge* nav_graph::exits_end(uint32_t node_id) const {
+    return edges.data() + offsets[node_id + 1];
+}
+
+bool nav_graph::passable(const edge& exit, const std::vector<symbol>* held) const {
+    if (!held || exit.requires_.empty()) {
+        return true;
+    }
+    return std::find(held->begin(), held->end(), exit.requires_) != held->end();
+}
+
+bool nav_graph::search(uint32_t from, uint32_t to, const std::vector<symbol>* held,
+    std::vector<uint32_t>& parent_edges) const {
+    parent_edges.assign(nodes.size(), no_node);
+    std::vector<bool> seen(nodes.size(), false);
+    std::deque<uint32_t> frontier;
+
+    seen[from] = true;
+    frontier.push_back(from);
+    while (!frontier.empty()) {
+        uint32_t current = frontier.front();
+        frontier.pop_front();
+        if (current == to) {
+            return true;
+        }
+
+        for (uint32_t e = offsets[current]; e < offsets[current + 1]; ++e) {
+            const edge& exit = edges[e];
+            if (seen[exit.target] || !passable(exit, held)) {
+                continue;
+            }
+            seen[exit.target] = true;
+            parent_edges[exit.target] = e;
+            frontier.push_back(exit.target);
+        }
+    }
+    return to == no_node;
+}
+
+bool nav_graph::route(uint32_t from, uint32_t to, const std::vector<symbol>* held,
+    std::vector<const edge*>& path) const {
+    path.clear();
+    if (from >= nodes.size() || to >= nodes.size()) {
+        return false;
+    }
+
+    std::vector<uint32_t> parent_edges;
+    if (!search(from, to, held, parent_edges)) {
+        return false;
+    }
+
+    // Walk parent edges back from the goal; each edge's source is the node
+    // whose row contains it.
+    for (uint32_t current = to; current != from;) {
+        uint32_t e = parent_edges[current];
+        path.push_back(&edges[e]);
+        current = static_cast<uint32_t>(std::upper_bound(offsets.begin(), offsets.end(), e) - offsets.begin() - 1);
+    }
+    std::reverse(path.begin(), path.end());
+    return true;
+}
+
+int nav_graph::distance(uint32_t from, uint32_t to, const std::vector<symbol>* held) const {
+    std::vector<const edge*> path;
+    if (!route(from, to, held, path)) {
+        return -1;
+    }
+    return static_cast<int>(path.size());
+}
+
+void nav_graph::reachable(uint32_t from, const std::vector<symbol>* held, std::vector<uint32_t>& result) const {
+    result.clear();
+    if (from >= nodes.size()) {
+        return;
+    }
+
+    std::vector<uint32_t> parent_edges;
+    search(from, no_node, held, parent_edges);
+    result.push_back(from);
+    for (uint32_t n = 0; n < nodes.size(); ++n) {
+        if (parent_edges[n] != no_node) {
+            result.push_back(n);
+        }
+    }
+}
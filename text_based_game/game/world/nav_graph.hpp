@@ -0,0 +1,64 @@
+#ifndef NAV_GRAPH_HPP
+#define NAV_GRAPH_HPP
+
+#include "../symbol/symbol_table.hpp"
+#include "../includes.hpp"
+#include <vector>
+#include <cstdint>
+#include <unordered_map>
+
+// Room connections flattened into compressed sparse rows: the exits of
+// node n are edges[offsets[n]] up to edges[offsets[n + 1]]. Built on
+// demand by world and thrown away whenever a room's exits change.
+class nav_graph {
+public:
+    static constexpr uint32_t no_node = 0xFFFFFFFFu;
+
+    struct edge {
+        uint32_t target;
+        symbol direction;
+        symbol requires_;
+    };
+
+private:
+    struct pending_edge {
+        symbol from;
+        symbol direction;
+        symbol to;
+        symbol requires_;
+    };
+
+    std::vector<symbol> nodes;
+    std::unordered_map<symbol, uint32_t> node_index;
+    std::vector<uint32_t> offsets;
+    std::vector<edge> edges;
+    std::vector<pending_edge> pending;
+    bool valid;
+
+    uint32_t add_node(symbol room_id);
+    bool passable(const edge& exit, const std::vector<symbol>* held) const;
+    bool search(uint32_t from, uint32_t to, const std::vector<symbol>* held,
+        std::vector<uint32_t>& parent_edges) const;
+
+public:
+    nav_graph();
+
+    void add_edge(symbol from, symbol direction, symbol to, symbol requires_);
+    void finalize();
+    void invalidate();
+    bool is_valid() const;
+
+    uint32_t node(symbol room_id) const;
+    symbol room_at(uint32_t node_id) const;
+    size_t node_count() const;
+    size_t edge_count() const;
+    const edge* exits_begin(uint32_t node_id) const;
+    const edge* exits_end(uint32_t node_id) const;
+
+    bool route(uint32_t from, uint32_t to, const std::vector<symbol>* held,
+        std::vector<const edge*>& path) const;
+    int distance(uint32_t from, uint32_t to, const std::vector<symbol>* held) const;
+    void reachable(uint32_t from, const std::vector<symbol>* held, std::vector<uint32_t>& result) const;
+};
+
+#endif
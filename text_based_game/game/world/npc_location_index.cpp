@@ -0,0 +1,54 @@
+#include "npc_location_index.hpp"
+#include "../npc/npc.hpp"
+#include <algorithm>
+
+void npc_location_index::erase_from(std::vector<npc*>& bucket, const npc* entry) {
+    auto it = std::find(bucket.begin(), bucket.end(), entry);
+
+    if (it != bucket.end()) {
+        bucket.erase(it);
+    }
+}
+
+void npc_location_index::insert(npc* entry) {
+    buckets[entry->get_current_room_symbol()].push_back(entry);
+    entry->set_location_index(this);
+}
+
+void npc_location_index::remove(const npc* entry) {
+    auto it = buckets.find(entry->get_current_room_symbol());
+    if (it != buckets.end()) {
+        erase_from(it->second, entry);
+    }
+}
+
+void npc_location_index::relocate(const npc* entry, symbol from, symbol to) {
+    if (from == to) {
+        return;
+    }
+
+    auto from_it = buckets.find(from);
+    if (from_it == buckets.end()) {
+        return;
+    }
+
+    auto& from_bucket = from_it->second;
+    auto it = std::find(from_bucket.begin(), from_bucket.end(), entry);
+    if (it == from_bucket.end()) {
+        return;
+    }
+
+    npc* moved = *it;
+    from_bucket.erase(it);
+    buckets[to].push_back(moved);
+}
+
+const std::vector<npc*>& npc_location_index::npcs_at(symbol room) const {
+    static const std::vector<npc*> empty_bucket;
+
+    auto it = buckets.find(room);
+    if (it != buckets.end()) {
+        return it->second;
+    }
+    return empty_bucket;
+}
@@ -0,0 +1,25 @@
+#ifndef NPC_LOCATION_INDEX_HPP
+#define NPC_LOCATION_INDEX_HPP
+
+#include "../symbol/symbol_table.hpp"
+#include "../includes.hpp"
+#include <vector>
+#include <unordered_map>
+
+class npc;
+
+class npc_location_index {
+private:
+    std::unordered_map<symbol, std::vector<npc*>> buckets;
+
+    static void erase_from(std::vector<npc*>& bucket, const npc* entry);
+
+public:
+    void insert(npc* entry);
+    void remove(const npc* entry);
+    void relocate(const npc* entry, symbol from, symbol to);
+
+    const std::vector<npc*>& npcs_at(symbol room) const;
+};
+
+#endif
@@ -0,0 +1,52 @@
+#include "room_cache.hpp"
+
+room_cache::room_cache(std::shared_ptr<room_source> room_loader, size_t byte_budget) :
+    source(std::move(room_loader)), budget(byte_budget), resident_bytes(0) {}
+
+room_cache::room_cache(const room_cache& other) :
+    source(other.source), budget(other.budget), resident_bytes(other.resident_bytes), recency(other.recency) {
+    for (auto it = recency.begin(); it != recency.end(); ++it) {
+        residents[*it] = { other.residents.at(*it).footprint, it };
+    }
+}
+
+std::shared_ptr<room> room_cache::fault(symbol room_id) {
+    size_t footprint = 0;
+    auto loaded = source->load_room(room_id, footprint);
+    if (!loaded) {
+        return nullptr;
+    }
+
+    loaded->clear_modified();
+    recency.push_front(room_id);
+    residents[room_id] = { footprint, recency.begin() };
+    resident_bytes += footprint;
+    return loaded;
+}
+
+void room_cache::touch(symbol room_id) {
+    auto it = residents.find(room_id);
+    if (it != residents.end() && it->second.position != recency.begin()) {
+        recency.splice(recency.begin(), recency, it->second.position);
+    }
+}
+
+void room_cache::trim(const std::function<void(symbol)>& evict) {
+    while (resident_bytes > budget && !recency.empty()) {
+        symbol room_id = recency.back();
+        recency.pop_back();
+
+        auto resident = residents.find(room_id);
+        resident_bytes -= resident->second.footprint;
+        residents.erase(resident);
+        evict(room_id);
+    }
+}
+
+void room_cache::visit_connections(const std::function<void(symbol, symbol, const room_connection&)>& visit) const {
+    source->visit_connections(visit);
+}
+
+size_t room_cache::get_resident_bytes() const {
+    return resident_bytes;
+}
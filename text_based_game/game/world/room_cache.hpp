@@ -0,0 +1,49 @@
+#ifndef ROOM_CACHE_HPP
+#define ROOM_CACHE_HPP
+
+#include "../room/room.hpp"
+#include "../symbol/symbol_table.hpp"
+#include "../includes.hpp"
+#include <functional>
+#include <list>
+#include <memory>
+#include <unordered_map>
+
+class room_source {
+public:
+    virtual ~room_source() = default;
+    virtual std::shared_ptr<room> load_room(symbol room_id, size_t& footprint) = 0;
+    virtual void visit_connections(const std::function<void(symbol, symbol, const room_connection&)>& visit) = 0;
+};
+
+// Tracks rooms faulted in from a room_source so the least recently used
+// unmodified ones can be dropped once their footprint exceeds the budget.
+// Modified rooms are pinned and no longer counted against the budget.
+// Callers hold rooms by plain pointer, so trim only between commands.
+class room_cache {
+private:
+    struct resident_room {
+        size_t footprint;
+        std::list<symbol>::iterator position;
+    };
+
+    std::shared_ptr<room_source> source;
+    size_t budget;
+    size_t resident_bytes;
+    std::list<symbol> recency;
+    std::unordered_map<symbol, resident_room> residents;
+
+public:
+    room_cache(std::shared_ptr<room_source> room_loader, size_t byte_budget);
+    room_cache(const room_cache& other);
+    room_cache& operator=(const room_cache&) = delete;
+
+    std::shared_ptr<room> fault(symbol room_id);
+    void touch(symbol room_id);
+    void trim(const std::function<void(symbol)>& evict);
+    void visit_connections(const std::function<void(symbol, symbol, const room_connection&)>& visit) const;
+
+    size_t get_resident_bytes() const;
+};
+
+#endif
@@ -0,0 +1,144 @@
+#ifndef SLOT_MAP_HPP
+#define SLOT_MAP_HPP
+
+#include "../includes.hpp"
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+template <typename T>
+struct slot_handle {
+    static constexpr uint32_t invalid_index = 0xFFFFFFFFu;
+
+    uint32_t index = invalid_index;
+    uint32_t generation = 0;
+
+    bool valid() const {
+        return index != invalid_index;
+    }
+
+    bool operator==(const slot_handle& other) const {
+        return index == other.index && generation == other.generation;
+    }
+
+    bool operator!=(const slot_handle& other) const {
+        return !(*this == other);
+    }
+};
+
+// Owns entities in stable slots. A slot's generation is bumped when its
+// entity is erased, so handles to the old occupant resolve to nullptr
+// instead of aliasing whatever reuses the slot.
+template <typename T>
+class slot_map {
+public:
+    using handle = slot_handle<T>;
+
+private:
+    struct slot {
+        std::shared_ptr<T> value;
+        uint32_t generation = 0;
+    };
+
+    std::vector<slot> slots;
+    std::vector<uint32_t> free_slots;
+    size_t live_count = 0;
+
+public:
+    class iterator {
+    private:
+        const slot* current;
+        const slot* last;
+
+        void skip_empty() {
+            while (current != last && !current->value) {
+                ++current;
+            }
+        }
+
+    public:
+        iterator(const slot* first, const slot* end) : current(first), last(end) {
+            skip_empty();
+        }
+
+        T& operator*() const {
+            return *current->value;
+        }
+
+        T* operator->() const {
+            return current->value.get();
+        }
+
+        iterator& operator++() {
+            ++current;
+            skip_empty();
+            return *this;
+        }
+
+        bool operator!=(const iterator& other) const {
+            return current != other.current;
+        }
+    };
+
+    handle insert(std::shared_ptr<T> value) {
+        uint32_t index;
+        if (!free_slots.empty()) {
+            index = free_slots.back();
+            free_slots.pop_back();
+        }
+        else {
+            index = static_cast<uint32_t>(slots.size());
+            slots.emplace_back();
+        }
+
+        slots[index].value = std::move(value);
+        ++live_count;
+        return { index, slots[index].generation };
+    }
+
+    bool erase(handle entry) {
+        if (!get(entry)) {
+            return false;
+        }
+
+        slot& target = slots[entry.index];
+        target.value.reset();
+        ++target.generation;
+        free_slots.push_back(entry.index);
+        --live_count;
+        return true;
+    }
+
+    T* get(handle entry) const {
+        if (entry.index >= slots.size() || slots[entry.index].generation != entry.generation) {
+            return nullptr;
+        }
+        return slots[entry.index].value.get();
+    }
+
+    T* at(uint32_t index) const {
+        return index < slots.size() ? slots[index].value.get() : nullptr;
+    }
+
+    void reserve(size_t count) {
+        slots.reserve(count);
+    }
+
+    size_t size() const {
+        return live_count;
+    }
+
+    bool empty() const {
+        return live_count == 0;
+    }
+
+    iterator begin() const {
+        return iterator(slots.data(), slots.data() + slots.size());
+    }
+
+    iterator end() const {
+        return iterator(slots.data() + slots.size(), slots.data() + slots.size());
+    }
+};
+
+#endif
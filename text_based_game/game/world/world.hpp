@@ -5,29 +5,76 @@
 #include "../item/item.hpp"
 #include "../npc/npc.hpp"
 #include "../player/player.hpp"
+#include "location_index.hpp"
+#include "npc_location_index.hpp"
+#include "name_index.hpp"
+#include "item_columns.hpp"
+#include "flag_set.hpp"
+#include "nav_graph.hpp"
+#include "room_cache.hpp"
+#include "slot_map.hpp"
+#include "../arena/world_arena.hpp"
+#include "../script/script_engine.hpp"
+#include "../symbol/symbol_table.hpp"
 #include "../includes.hpp"
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <memory>
 #include <vector>
 
+class world_journal;
+
+using room_handle = slot_handle<room>;
+using item_handle = slot_handle<item>;
+using npc_handle = slot_handle<npc>;
+
 class world {
 private:
+    std::shared_ptr<world_arena> arena;
     std::string world_name;
     std::string world_description;
-    std::unordered_map<std::string, std::shared_ptr<room>> rooms;
-    std::unordered_map<std::string, std::shared_ptr<item>> items;
-    std::vector<std::shared_ptr<npc>> npcs;
-    std::unordered_map<std::string, bool> game_flags;
-    std::string starting_room;
-    std::vector<std::string> starting_inventory;
+    mutable slot_map<room> rooms;
+    mutable std::unordered_map<symbol, room_handle> room_slots;
+    std::unique_ptr<room_cache> lazy_rooms;
+    std::unique_ptr<nav_graph> navigation;
+    slot_map<item> items;
+    std::unordered_map<symbol, item_handle> item_slots;
+    std::unique_ptr<location_index> item_locations;
+    std::unique_ptr<item_columns> item_table;
+    std::shared_ptr<name_index> item_names;
+    slot_map<npc> npcs;
+    std::unordered_map<symbol, npc_handle> npc_slots;
+    std::unique_ptr<npc_location_index> npc_locations;
+    std::shared_ptr<name_index> npc_names;
+    flag_set game_flags;
+    symbol starting_room;
+    std::vector<symbol> starting_inventory;
     int player_health;
     int player_inventory_size;
     std::string current_day_cycle;
     std::string current_weather;
+    std::shared_ptr<const script_engine> scripts;
+    world_journal* journal;
+
+    static name_index& edit_names(std::shared_ptr<name_index>& names);
+    void attach_item(const std::shared_ptr<item>& entry);
+    std::vector<item*> items_in_rows(const std::vector<std::uint32_t>& rows) const;
+    std::vector<symbol> held_items(const player& traveller) const;
+    void follow_connection(player& player, const room_connection* connection);
 
 public:
     world();
+    world(const world&) = delete;
+    world& operator=(const world&) = delete;
+    world(world&&) = default;
+    world& operator=(world&&) = default;
+
+    world instantiate() const;
+
+    std::shared_ptr<room> create_room(symbol room_id) const;
+    std::shared_ptr<item> create_item(symbol item_id) const;
+    std::shared_ptr<npc> create_npc(const std::string& npc_id) const;
 
     void set_world_name(const std::string& name);
     std::string get_world_name() const;
@@ -36,26 +83,56 @@ public:
     std::string get_world_description() const;
 
     void add_room(const std::shared_ptr<room>& new_room);
-    std::shared_ptr<room> get_room(const std::string& room_id) const;
+    room* get_room(const std::string& room_id) const;
+    room* get_room(symbol room_id) const;
+    room* get_room(room_handle handle) const;
+    room_handle find_room(symbol room_id) const;
+    const slot_map<room>& get_rooms() const;
+    void set_room_source(const std::shared_ptr<room_source>& source, size_t byte_budget);
+    void trim_rooms();
+    void build_name_indexes();
+
+    const nav_graph& get_navigation() const;
+    std::vector<symbol> find_route(symbol from, symbol to, const player* traveller = nullptr) const;
+    std::vector<symbol> get_reachable_rooms(symbol from, const player& traveller) const;
+    int get_distance_to_npc(symbol from, symbol npc_id) const;
 
     void add_item(const std::shared_ptr<item>& new_item);
-    std::shared_ptr<item> get_item(const std::string& item_id) const;
-    std::vector<std::shared_ptr<item>> get_items_in_room(const std::string& room_id) const;
+    // Frees the item; callers must drop any raw pointers to it first.
+    bool remove_item(symbol item_id);
+    item* get_item(const std::string& item_id) const;
+    item* get_item(symbol item_id) const;
+    item* get_item(item_handle handle) const;
+    item_handle find_item(symbol item_id) const;
+    const slot_map<item>& get_items() const;
+    const std::vector<item*>& get_items_in_room(const std::string& room_id) const;
+    const std::vector<item*>& get_items_in_room(symbol room_id) const;
+    std::vector<item*> get_items_of_type(const std::string& type) const;
+    std::vector<item*> get_items_named(const std::string& name) const;
+    std::vector<item*> get_items_flagged(const std::string& property) const;
 
     void add_npc(const std::shared_ptr<npc>& new_npc);
-    std::shared_ptr<npc> get_npc(const std::string& npc_id) const;
-    std::vector<std::shared_ptr<npc>> get_npcs_in_room(const std::string& room_id) const;
-    const std::vector<std::shared_ptr<npc>>& get_npcs() const;
-
+    npc* get_npc(const std::string& npc_id) const;
+    npc* get_npc(symbol npc_id) const;
+    npc* get_npc(npc_handle handle) const;
+    npc_handle find_npc(symbol npc_id) const;
+    const std::vector<npc*>& get_npcs_in_room(const std::string& room_id) const;
+    const std::vector<npc*>& get_npcs_in_room(symbol room_id) const;
+    const slot_map<npc>& get_npcs() const;
+
+    void declare_flag(symbol flag);
     void set_game_flag(const std::string& flag, bool value);
+    void set_game_flag(symbol flag, bool value);
     bool get_game_flag(const std::string& flag) const;
-    const std::unordered_map<std::string, bool>& get_game_flags() const;
+    bool get_game_flag(symbol flag) const;
+    std::vector<std::pair<symbol, bool>> get_game_flags() const;
+    void clear_game_flags();
 
     void set_starting_room(const std::string& room_id);
-    std::string get_starting_room() const;
+    const std::string& get_starting_room() const;
 
     void add_starting_item(const std::string& item_id);
-    const std::vector<std::string>& get_starting_inventory() const;
+    const std::vector<symbol>& get_starting_inventory() const;
 
     void set_player_health(int health);
     int get_player_health() const;
@@ -64,8 +141,11 @@ public:
     int get_player_inventory_size() const;
 
     std::string get_room_description(const std::string& room_id, bool include_contents) const;
+    std::string get_room_description(symbol room_id, bool include_contents) const;
 
     void move_player(player& player, const std::string& direction);
+    void move_player(player& player, symbol direction);
+    void move_player(player& player, exit_direction direction);
     void update_npcs(player& player);
     void update_npc_state(const std::string& npc_id, const std::string& room_id, const std::string& state);
     void ensure_npcs_in_proper_locations();
@@ -76,7 +156,12 @@ public:
     void set_weather(const std::string& weather);
     std::string get_weather() const;
 
-    bool process_special_command(const std::string& verb, const std::string& object, player& player);
+    void set_scripts(const std::shared_ptr<const script_engine>& engine);
+    const std::shared_ptr<const script_engine>& get_scripts() const;
+
+    void set_journal(world_journal* owner);
+
+    bool process_special_command(std::string_view verb, std::string_view object, player& player);
 };
 
 #endif 
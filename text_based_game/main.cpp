@@ -1,13 +1,49 @@
 #include "../game/game_engine/game_engine.hpp"
+#include "../game/server/game_server.hpp"
+#include "../game/pack/content_pack.hpp"
+#include "../game/batch/batch_runner.hpp"
 #include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
 
-int main() {
-    game_engine engine;
+int main(int argc, char* argv[]) {
+    if (argc >= 3 && std::string(argv[1]) == "--server") {
+        game_server server(argv[2]);
+        if (!server.listen()) {
+            return 1;
+        }
+        server.run();
+        return 0;
+    }
+
+    if (argc >= 4 && std::string(argv[1]) == "--compile-pack") {
+        if (!content_pack::compile(argv[2], argv[3])) {
+            return 1;
+        }
+        std::cout << "Compiled content pack: " << argv[3] << std::endl;
+        return 0;
+    }
+
+    if (argc >= 3 && std::string(argv[1]) == "--batch") {
+        std::ifstream commands(argv[2]);
+        if (!commands) {
+            std::cerr << "Could not open command file: " << argv[2] << std::endl;
+            return 1;
+        }
 
-    std::cout << "Welcome to The Labyrinth of Echoes!\n";
-    std::cout << "A fractured realm where ancient magic and steampunk technology coexist.\n";
-    std::cout << "Type 'help' for a list of commands.\n\n";
+        game_engine engine;
+        batch_runner batch(engine, false);
+        std::ostringstream output;
+        batch.start(output);
+        batch.run(commands, output);
+        std::cout << output.str();
+        return 0;
+    }
+
+    game_engine engine;
 
+    engine.print_welcome();
     engine.initialize();
     engine.run();
 
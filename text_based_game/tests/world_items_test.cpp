@@ -0,0 +1,102 @@
+// Standalone regression checks for world item and NPC storage. Build
+// from text_based_game/ with:
+//   g++ -std=c++20 -Inlohmann -pthread tests/world_items_test.cpp
+//       $(find game -iname '*.cpp') -o world_items_test
+#include "../game/world/world.hpp"
+#include "../game/player/player.hpp"
+#include "../game/npc/npc.hpp"
+#include <iostream>
+
+static int failures = 0;
+
+static void check(bool condition, const char* message) {
+    if (!condition) {
+        std::cerr << "FAILED: " << message << std::endl;
+        ++failures;
+    }
+}
+
+// Re-adding an item id must not free the object a player is carrying.
+static void readd_item_keeps_held_pointer() {
+    world game_world;
+    player hero;
+    hero.set_current_room("hall");
+
+    auto original = game_world.create_item(symbol("crystal_fragment_1"));
+    original->set_name("Crystal Fragment 1");
+    original->set_location("hall");
+    game_world.add_item(original);
+
+    item* held = game_world.get_item("crystal_fragment_1");
+    check(hero.add_to_inventory(held), "item can be picked up");
+
+    auto respawned = game_world.create_item(symbol("crystal_fragment_1"));
+    respawned->set_name("Crystal Fragment 1");
+    respawned->set_location("hall");
+    original.reset();
+    game_world.add_item(respawned);
+
+    check(game_world.get_item("crystal_fragment_1") == held, "re-added id keeps its object");
+    check(hero.get_inventory().size() == 1 && hero.get_inventory().front() == held, "inventory still holds the item");
+    check(held->get_name() == "Crystal Fragment 1", "held item takes the new state");
+    check(game_world.get_items_in_room("hall").size() == 1, "room lists the item once");
+    check(game_world.get_items_named("Crystal Fragment 1").size() == 1, "column store has one row for the id");
+}
+
+// Freed rows have empty columns, so an empty-symbol query must not
+// return them.
+static void removed_rows_are_not_selected() {
+    world game_world;
+
+    auto untyped = game_world.create_item(symbol("pebble"));
+    untyped->set_location("hall");
+    game_world.add_item(untyped);
+
+    auto removed = game_world.create_item(symbol("feather"));
+    removed->set_location("hall");
+    game_world.add_item(removed);
+    game_world.remove_item(symbol("feather"));
+
+    std::vector<item*> found = game_world.get_items_of_type("");
+    check(found.size() == 1, "empty type selects only the live row");
+    for (item* entry : found) {
+        check(entry != nullptr, "selected rows are never null");
+    }
+}
+
+// Re-adding an NPC id must replace the stored NPC, not orphan a slot.
+static void readd_npc_replaces_slot() {
+    world game_world;
+
+    auto original = game_world.create_npc("keeper");
+    original->set_name("Keeper");
+    original->set_current_room("gate");
+    game_world.add_npc(original);
+    npc* stored = game_world.get_npc(symbol("keeper"));
+
+    auto replacement = game_world.create_npc("keeper");
+    replacement->set_name("Old Keeper");
+    replacement->set_current_room("tower");
+    game_world.add_npc(replacement);
+
+    check(game_world.get_npcs().size() == 1, "re-added id keeps a single NPC");
+    check(game_world.get_npc(symbol("keeper")) == stored, "re-added id keeps its slot");
+    check(stored->get_name() == "Old Keeper", "stored NPC takes the new state");
+    check(game_world.get_npcs_in_room("gate").empty(), "old room no longer lists the NPC");
+    check(game_world.get_npcs_in_room("tower").size() == 1, "new room lists the NPC once");
+    check(game_world.get_npc("Old Keeper") == stored, "new name resolves to the stored NPC");
+
+    replacement->set_current_room("gate");
+    check(game_world.get_npcs_in_room("gate").empty(), "moving the discarded copy leaves the index alone");
+}
+
+int main() {
+    readd_item_keeps_held_pointer();
+    removed_rows_are_not_selected();
+    readd_npc_replaces_slot();
+
+    if (failures == 0) {
+        std::cout << "All world item tests passed." << std::endl;
+    }
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,146 @@
+// Standalone checks for world navigation queries. Build from
+// text_based_game/ with:
+//   g++ -std=c++20 -Inlohmann -pthread tests/world_navigation_test.cpp
+//       $(find game -iname '*.cpp') -o world_navigation_test
+#include "../game/world/world.hpp"
+#include "../game/player/player.hpp"
+#include "../game/npc/npc.hpp"
+#include <algorithm>
+#include <iostream>
+
+static int failures = 0;
+
+static void check(bool condition, const char* message) {
+    if (!condition) {
+        std::cerr << "FAILED: " << message << std::endl;
+        ++failures;
+    }
+}
+
+static bool same_route(const std::vector<symbol>& route, std::initializer_list<const char*> directions) {
+    if (route.size() != directions.size()) {
+        return false;
+    }
+    return std::equal(route.begin(), route.end(), directions.begin(),
+        [](symbol step, const char* direction) { return step.str() == direction; });
+}
+
+static bool contains(const std::vector<symbol>& rooms, const char* room_id) {
+    return std::find(rooms.begin(), rooms.end(), symbol(room_id)) != rooms.end();
+}
+
+static void add_room(world& game_world, const char* room_id) {
+    game_world.add_room(game_world.create_room(symbol(room_id)));
+}
+
+static void add_key(world& game_world) {
+    auto key = game_world.create_item(symbol("brass_key"));
+    key->set_name("Brass Key");
+    key->set_location("gate");
+    game_world.add_item(key);
+}
+
+// gate -east-> bridge -north(brass_key)-> tower is the short way round;
+// gate -south-> marsh -east-> ford -north-> tower is open to anyone, and
+// the vault west of the gate is only reachable with the key.
+static void build_map(world& game_world) {
+    for (const char* room_id : { "gate", "bridge", "tower", "marsh", "ford", "vault" }) {
+        add_room(game_world, room_id);
+    }
+    game_world.get_room("gate")->add_connection("east", "bridge");
+    game_world.get_room("bridge")->add_connection("north", "tower", "brass_key");
+    game_world.get_room("gate")->add_connection("south", "marsh");
+    game_world.get_room("marsh")->add_connection("east", "ford");
+    game_world.get_room("ford")->add_connection("north", "tower");
+    game_world.get_room("gate")->add_connection("west", "vault", "brass_key");
+}
+
+static void routes_respect_required_items() {
+    world game_world;
+    build_map(game_world);
+    player hero;
+    hero.set_current_room("gate");
+
+    check(same_route(game_world.find_route(symbol("gate"), symbol("tower")), { "east", "north" }),
+        "route ignoring items takes the locked bridge");
+    check(same_route(game_world.find_route(symbol("gate"), symbol("tower"), &hero), { "south", "east", "north" }),
+        "route without the key goes round by the ford");
+    check(game_world.find_route(symbol("gate"), symbol("vault"), &hero).empty(),
+        "vault has no route without the key");
+
+    std::vector<symbol> reachable = game_world.get_reachable_rooms(symbol("gate"), hero);
+    check(reachable.size() == 5 && contains(reachable, "tower") && !contains(reachable, "vault"),
+        "reachable rooms without the key exclude the vault");
+
+    // The key is created after the graph was built, so the edge must not
+    // have cached the missing item.
+    add_key(game_world);
+    check(hero.add_to_inventory(game_world.get_item("brass_key")), "key can be picked up");
+    check(same_route(game_world.find_route(symbol("gate"), symbol("tower"), &hero), { "east", "north" }),
+        "route with the key takes the bridge");
+    check(same_route(game_world.find_route(symbol("gate"), symbol("vault"), &hero), { "west" }),
+        "vault opens with the key");
+    check(contains(game_world.get_reachable_rooms(symbol("gate"), hero), "vault"),
+        "reachable rooms with the key include the vault");
+
+    // Removing and re-creating the key must not leave a stale requirement.
+    hero.clear_inventory();
+    check(game_world.remove_item(symbol("brass_key")), "key can be removed");
+    add_key(game_world);
+    check(hero.add_to_inventory(game_world.get_item("brass_key")), "re-created key can be picked up");
+    check(same_route(game_world.find_route(symbol("gate"), symbol("vault"), &hero), { "west" }),
+        "re-created key still opens the vault");
+}
+
+static void distance_to_npc_counts_hops() {
+    world game_world;
+    build_map(game_world);
+
+    auto keeper = game_world.create_npc("keeper");
+    keeper->set_current_room("tower");
+    game_world.add_npc(keeper);
+
+    check(game_world.get_distance_to_npc(symbol("gate"), symbol("keeper")) == 2, "keeper is two hops away");
+    check(game_world.get_distance_to_npc(symbol("tower"), symbol("keeper")) == 0, "keeper is in the tower");
+    check(game_world.get_distance_to_npc(symbol("gate"), symbol("nobody")) == -1, "unknown npc has no distance");
+}
+
+static bool only_npc(const std::vector<npc*>& npcs, const npc* expected) {
+    return npcs.size() == 1 && npcs.front() == expected;
+}
+
+// The room index follows NPC moves, and an instantiated world indexes
+// its own copies rather than the template's.
+static void npcs_in_room_follow_moves() {
+    world template_world;
+    build_map(template_world);
+
+    auto keeper = template_world.create_npc("keeper");
+    keeper->set_current_room("tower");
+    template_world.add_npc(keeper);
+    check(only_npc(template_world.get_npcs_in_room("tower"), keeper.get()), "keeper starts in the tower");
+
+    keeper->set_current_room("gate");
+    check(template_world.get_npcs_in_room("tower").empty(), "tower is empty after the keeper leaves");
+    check(only_npc(template_world.get_npcs_in_room("gate"), keeper.get()), "keeper is listed at the gate");
+
+    world game_world = template_world.instantiate();
+    npc* copy = game_world.get_npc(symbol("keeper"));
+    check(copy != keeper.get() && only_npc(game_world.get_npcs_in_room("gate"), copy),
+        "instance lists its own keeper");
+
+    copy->set_current_room("marsh");
+    check(only_npc(game_world.get_npcs_in_room("marsh"), copy), "instance keeper moves to the marsh");
+    check(only_npc(template_world.get_npcs_in_room("gate"), keeper.get()), "template keeper stays at the gate");
+}
+
+int main() {
+    routes_respect_required_items();
+    distance_to_npc_counts_hops();
+    npcs_in_room_follow_moves();
+
+    if (failures == 0) {
+        std::cout << "All world navigation tests passed." << std::endl;
+    }
+    return failures == 0 ? 0 : 1;
+}